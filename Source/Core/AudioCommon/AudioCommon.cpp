@@ -11,6 +11,7 @@
 #include "AudioCommon/OpenSLESStream.h"
 #include "AudioCommon/PulseAudioStream.h"
 #include "AudioCommon/WASAPIStream.h"
+#include "AudioCommon/WaveFile.h"
 #include "Common/Common.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
@@ -24,6 +25,8 @@ namespace AudioCommon
 {
 static bool s_audio_dump_start = false;
 static bool s_sound_stream_running = false;
+static std::string s_audio_render_path;
+static std::unique_ptr<WaveFileWriter> s_audio_render_writer;
 
 constexpr int AUDIO_VOLUME_MIN = 0;
 constexpr int AUDIO_VOLUME_MAX = 100;
@@ -47,9 +50,27 @@ static std::unique_ptr<SoundStream> CreateSoundStreamForBackend(std::string_view
   return {};
 }
 
+static void StartAudioRender()
+{
+  // Nobody is around to answer the question WaveFileWriter asks about existing files.
+  File::CreateFullPath(s_audio_render_path);
+  File::Delete(s_audio_render_path);
+
+  s_audio_render_writer = std::make_unique<WaveFileWriter>();
+  if (!s_audio_render_writer->Start(s_audio_render_path, AudioInterface::GetAIDSampleRate()))
+  {
+    ERROR_LOG_FMT(AUDIO, "Could not start rendering audio to {}", s_audio_render_path);
+    s_audio_render_writer.reset();
+    return;
+  }
+  s_audio_render_writer->SetSkipSilence(false);
+  NOTICE_LOG_FMT(AUDIO, "Rendering audio to {}", s_audio_render_path);
+}
+
 void InitSoundStream()
 {
-  std::string backend = SConfig::GetInstance().sBackend;
+  std::string backend =
+      s_audio_render_path.empty() ? SConfig::GetInstance().sBackend : BACKEND_NULLSOUND;
   g_sound_stream = CreateSoundStreamForBackend(backend);
 
   if (!g_sound_stream)
@@ -76,6 +97,9 @@ void InitSoundStream()
   UpdateSoundStream();
   SetSoundStreamRunning(true);
 
+  if (!s_audio_render_path.empty())
+    StartAudioRender();
+
   if (SConfig::GetInstance().m_DumpAudio && !s_audio_dump_start)
     StartAudioDump();
 }
@@ -87,7 +111,15 @@ void ShutdownSoundStream()
   if (SConfig::GetInstance().m_DumpAudio && s_audio_dump_start)
     StopAudioDump();
 
+  s_audio_render_writer.reset();
+
   SetSoundStreamRunning(false);
+  if (g_sound_stream)
+  {
+    const Mixer::LatencyStatistics stats = g_sound_stream->GetMixer()->GetLatencyStatistics();
+    NOTICE_LOG_FMT(AUDIO, "Audio latency: {:.1f} ms target, {:.1f} ms buffered, {} underruns",
+                   stats.target_ms, stats.buffered_ms, stats.underruns);
+  }
   g_sound_stream.reset();
 
   INFO_LOG_FMT(AUDIO, "Done shutting down sound stream");
@@ -194,6 +226,16 @@ void SendAIBuffer(const short* samples, unsigned int num_samples)
   else if (!SConfig::GetInstance().m_DumpAudio && s_audio_dump_start)
     StopAudioDump();
 
+  if (s_audio_render_writer)
+  {
+    if (samples)
+    {
+      s_audio_render_writer->AddStereoSamplesBE(samples, num_samples,
+                                                AudioInterface::GetAIDSampleRate());
+    }
+    return;
+  }
+
   Mixer* pMixer = g_sound_stream->GetMixer();
 
   if (pMixer && samples)
@@ -224,6 +266,11 @@ void StopAudioDump()
   s_audio_dump_start = false;
 }
 
+void SetAudioRenderPath(std::string path)
+{
+  s_audio_render_path = std::move(path);
+}
+
 void IncreaseVolume(unsigned short offset)
 {
   SConfig::GetInstance().m_IsMuted = false;
@@ -31,6 +31,11 @@ void SetSoundStreamRunning(bool running);
 void SendAIBuffer(const short* samples, unsigned int num_samples);
 void StartAudioDump();
 void StopAudioDump();
+
+// Renders the audio output of the DSP to a WAV file instead of playing it. This must be set before
+// the sound stream is initialized. No backend is used and the mixer is bypassed, so the file only
+// depends on the emulated audio, not on the speed of emulation. An empty path disables it.
+void SetAudioRenderPath(std::string path);
 void IncreaseVolume(unsigned short offset);
 void DecreaseVolume(unsigned short offset);
 void ToggleMuteVolume();
@@ -59,9 +59,17 @@ bool CubebStream::Init()
     ERROR_LOG_FMT(AUDIO, "Error getting minimum latency");
   INFO_LOG_FMT(AUDIO, "Minimum latency: {} frames", minimum_latency);
 
-  return cubeb_stream_init(m_ctx.get(), &m_stream, "Dolphin Audio Output", nullptr, nullptr,
-                           nullptr, &params, std::max(BUFFER_SAMPLES, minimum_latency),
-                           DataCallback, StateCallback, this) == CUBEB_OK;
+  if (cubeb_stream_init(m_ctx.get(), &m_stream, "Dolphin Audio Output", nullptr, nullptr, nullptr,
+                        &params, std::max(BUFFER_SAMPLES, minimum_latency), DataCallback,
+                        StateCallback, this) != CUBEB_OK)
+  {
+    return false;
+  }
+
+  if (!m_stereo)
+    m_mixer->StartSurroundDecoder();
+
+  return true;
 }
 
 bool CubebStream::SetRunning(bool running)
@@ -9,9 +9,16 @@
 #include <cmath>
 #include <cstring>
 
+#ifdef _M_X86
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -41,6 +48,8 @@ Mixer::Mixer(unsigned int BackendSampleRate)
 
 Mixer::~Mixer()
 {
+  // The decoding thread mixes samples, so it has to be stopped before anything is destroyed.
+  StopSurroundDecoder();
 }
 
 void Mixer::DoState(PointerWrap& p)
@@ -50,6 +59,102 @@ void Mixer::DoState(PointerWrap& p)
   m_wiimote_speaker_mixer.DoState(p);
 }
 
+const std::array<Mixer::ResamplerPhase, Mixer::RESAMPLER_PHASES>& Mixer::GetResamplerFilter()
+{
+  static const auto filter = [] {
+    std::array<ResamplerPhase, RESAMPLER_PHASES> phases;
+    constexpr double half_width = RESAMPLER_TAPS / 2;
+    constexpr s32 unity = 1 << 14;
+
+    for (u32 p = 0; p < RESAMPLER_PHASES; ++p)
+    {
+      // Blackman-windowed sinc, cut off at the Nyquist frequency of the input.
+      const double frac = static_cast<double>(p) / RESAMPLER_PHASES;
+      std::array<double, RESAMPLER_TAPS> weights;
+      double sum = 0.0;
+      for (u32 i = 0; i < RESAMPLER_TAPS; ++i)
+      {
+        const double x = static_cast<double>(i) - RESAMPLER_HISTORY - frac;
+        const double sinc = x == 0.0 ? 1.0 : std::sin(MathUtil::PI * x) / (MathUtil::PI * x);
+        const double window = 0.42 + 0.5 * std::cos(MathUtil::PI * x / half_width) +
+                              0.08 * std::cos(2.0 * MathUtil::PI * x / half_width);
+        weights[i] = sinc * window;
+        sum += weights[i];
+      }
+
+      // Normalize each phase, so that a constant signal keeps its level whatever the position.
+      ResamplerPhase& phase = phases[p];
+      s32 total = 0;
+      u32 largest = 0;
+      for (u32 i = 0; i < RESAMPLER_TAPS; ++i)
+      {
+        phase.taps[i] = static_cast<s16>(std::lround(weights[i] / sum * unity));
+        total += phase.taps[i];
+        if (weights[i] > weights[largest])
+          largest = i;
+      }
+      phase.taps[largest] += unity - total;
+
+      for (u32 i = 0; i < RESAMPLER_TAPS; i += 2)
+      {
+        phase.paired_taps[i * 2 + 0] = phase.taps[i];
+        phase.paired_taps[i * 2 + 1] = phase.taps[i + 1];
+        phase.paired_taps[i * 2 + 2] = phase.taps[i];
+        phase.paired_taps[i * 2 + 3] = phase.taps[i + 1];
+      }
+    }
+    return phases;
+  }();
+  return filter;
+}
+
+void Mixer::ApplyResampler(const std::array<short, MAX_SAMPLES * 2>& buffer, u32 first,
+                           const ResamplerPhase& phase, int* left, int* right)
+{
+#if defined(_M_X86) || defined(_M_ARM_64)
+  // The vector loads can't wrap around the end of the buffer.
+  if (first + RESAMPLER_TAPS * 2 <= MAX_SAMPLES * 2)
+  {
+#ifdef _M_X86
+    const auto load = [](const short* source) {
+      // Byteswap and move the samples of two consecutive pairs of the same channel next to
+      // each other, so that _mm_madd_epi16 sums them.
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+      v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+      v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 1, 2, 0));
+      return _mm_shufflehi_epi16(v, _MM_SHUFFLE(3, 1, 2, 0));
+    };
+    const __m128i* taps = reinterpret_cast<const __m128i*>(phase.paired_taps.data());
+    __m128i sum = _mm_add_epi32(_mm_madd_epi16(load(&buffer[first]), taps[0]),
+                                _mm_madd_epi16(load(&buffer[first + 8]), taps[1]));
+    sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+    *left = _mm_cvtsi128_si32(sum);
+    *right = _mm_cvtsi128_si32(_mm_srli_si128(sum, 4));
+#else
+    const int16x8x2_t v = vld2q_s16(&buffer[first]);
+    const int16x8_t l = vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(v.val[0])));
+    const int16x8_t r = vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(v.val[1])));
+    const int16x8_t taps = vld1q_s16(phase.taps.data());
+    *left = vaddvq_s32(vmlal_high_s16(vmull_s16(vget_low_s16(l), vget_low_s16(taps)), l, taps));
+    *right = vaddvq_s32(vmlal_high_s16(vmull_s16(vget_low_s16(r), vget_low_s16(taps)), r, taps));
+#endif
+    return;
+  }
+#endif
+
+  int sum_left = 0;
+  int sum_right = 0;
+  for (u32 i = 0; i < RESAMPLER_TAPS; ++i)
+  {
+    const s16 sample_left = Common::swap16(buffer[(first + i * 2) & INDEX_MASK]);
+    const s16 sample_right = Common::swap16(buffer[(first + i * 2 + 1) & INDEX_MASK]);
+    sum_left += sample_left * phase.taps[i];
+    sum_right += sample_right * phase.taps[i];
+  }
+  *left = sum_left;
+  *right = sum_right;
+}
+
 // Executed from sound stream thread
 unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
                                    bool consider_framelimit)
@@ -76,7 +181,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   {
     float numLeft = static_cast<float>(((indexW - indexR) & INDEX_MASK) / 2);
 
-    u32 low_waterwark = m_input_sample_rate * SConfig::GetInstance().iTimingVariance / 1000;
+    u32 low_waterwark =
+        static_cast<u32>(m_input_sample_rate * m_mixer->m_target_latency_ms.load() / 1000);
     low_waterwark = std::min(low_waterwark, MAX_SAMPLES / 2);
 
     m_numLeftI = (numLeft + m_numLeftI * (CONTROL_AVG - 1)) / CONTROL_AVG;
@@ -94,21 +200,24 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   s32 lvolume = m_LVolume.load();
   s32 rvolume = m_RVolume.load();
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  const auto& filter = GetResamplerFilter();
+  for (; currentSample < numSamples * 2 &&
+         ((indexW - indexR) & INDEX_MASK) > RESAMPLER_LOOKAHEAD * 2;
+       currentSample += 2)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = Common::swap16(m_buffer[indexR & INDEX_MASK]);   // current
-    s16 l2 = Common::swap16(m_buffer[indexR2 & INDEX_MASK]);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
+    const ResamplerPhase& phase = filter[m_frac * RESAMPLER_PHASES >> 16];
+    const u32 first = (indexR - RESAMPLER_HISTORY * 2) & INDEX_MASK;
+    int sampleL;
+    int sampleR;
+    ApplyResampler(m_buffer, first, phase, &sampleL, &sampleR);
+
+    // The filter can overshoot on full-scale input.
+    sampleL = std::clamp(sampleL >> 14, -32768, 32767);
     sampleL = (sampleL * lvolume) >> 8;
     sampleL += samples[currentSample + 1];
     samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
 
-    s16 r1 = Common::swap16(m_buffer[(indexR + 1) & INDEX_MASK]);   // current
-    s16 r2 = Common::swap16(m_buffer[(indexR2 + 1) & INDEX_MASK]);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
+    sampleR = std::clamp(sampleR >> 14, -32768, 32767);
     sampleR = (sampleR * rvolume) >> 8;
     sampleR += samples[currentSample];
     samples[currentSample] = std::clamp(sampleR, -32767, 32767);
@@ -121,6 +230,16 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   // Actual number of samples written to the buffer without padding.
   unsigned int actual_sample_count = currentSample / 2;
 
+  // Only count the FIFO running dry, not every call while it stays empty.
+  const bool starved = actual_sample_count < numSamples;
+  if (starved && !m_starved)
+  {
+    m_underruns++;
+    DEBUG_LOG_FMT(AUDIO, "Mixer FIFO underrun ({} of {} samples)", actual_sample_count,
+                  numSamples);
+  }
+  m_starved = starved;
+
   // Padding
   short s[2];
   s[0] = Common::swap16(m_buffer[(indexR - 1) & INDEX_MASK]);
@@ -147,6 +266,13 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   if (!samples)
     return 0;
 
+  UpdateLatencyTarget();
+  MixStereo(samples, num_samples);
+  return num_samples;
+}
+
+void Mixer::MixStereo(short* samples, unsigned int num_samples)
+{
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
   if (SConfig::GetInstance().m_audio_stretch)
@@ -175,8 +301,6 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
     m_wiimote_speaker_mixer.Mix(samples, num_samples, true);
     m_is_stretching = false;
   }
-
-  return num_samples;
 }
 
 unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
@@ -184,23 +308,27 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
   if (!num_samples)
     return 0;
 
-  memset(samples, 0, num_samples * SURROUND_CHANNELS * sizeof(float));
+  // The decoding thread pulls stereo samples whenever it falls behind, so the latency target is
+  // sized from the intervals between the backend callbacks here instead.
+  UpdateLatencyTarget();
 
-  size_t needed_frames = m_surround_decoder.QueryFramesNeededForSurroundOutput(num_samples);
+  const size_t decoded_frames = m_surround_decoder.ReceiveFrames(samples, num_samples);
+  if (decoded_frames != num_samples)
+    DEBUG_LOG_FMT(AUDIO, "Surround decoder underrun: {} of {} frames", decoded_frames, num_samples);
 
-  // Mix() may also use m_scratch_buffer internally, but is safe because it alternates reads
-  // and writes.
-  size_t available_frames = Mix(m_scratch_buffer.data(), static_cast<u32>(needed_frames));
-  if (available_frames != needed_frames)
-  {
-    ERROR_LOG_FMT(AUDIO, "Error decoding surround frames.");
-    return 0;
-  }
+  return num_samples;
+}
 
-  m_surround_decoder.PutFrames(m_scratch_buffer.data(), needed_frames);
-  m_surround_decoder.ReceiveFrames(samples, num_samples);
+void Mixer::StartSurroundDecoder()
+{
+  m_surround_decoder.Start([this](short* stereo_samples, u32 num_frames) {
+    MixStereo(stereo_samples, num_frames);
+  });
+}
 
-  return num_samples;
+void Mixer::StopSurroundDecoder()
+{
+  m_surround_decoder.Stop();
 }
 
 void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_samples)
@@ -212,8 +340,12 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
 
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  // The resampler also reads the samples right before indexR, so they must not be overwritten.
+  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) + RESAMPLER_HISTORY * 2 >=
+      MAX_SAMPLES * 2)
+  {
     return;
+  }
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
   // to alleviate the workload on main thread
@@ -234,6 +366,8 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
 
 void Mixer::PushSamples(const short* samples, unsigned int num_samples)
 {
+  m_push_interval_peak_us.store(
+      UpdateIntervalPeak(m_push_interval_peak_us.load(), &m_last_push_time));
   m_dma_mixer.PushSamples(samples, num_samples);
   int sample_rate = m_dma_mixer.GetInputSampleRate();
   if (m_log_dsp_audio)
@@ -267,6 +401,41 @@ void Mixer::PushWiimoteSpeakerSamples(const short* samples, unsigned int num_sam
   }
 }
 
+u32 Mixer::UpdateIntervalPeak(u32 peak_us, std::chrono::steady_clock::time_point* last_time)
+{
+  const auto now = std::chrono::steady_clock::now();
+  const auto interval = now - *last_time;
+  *last_time = now;
+  if (interval > MAX_TRACKED_INTERVAL)
+    return peak_us;
+
+  // Let the peak decay slowly, so that the target shrinks again once the jitter goes away.
+  const u32 interval_us =
+      static_cast<u32>(std::chrono::duration_cast<std::chrono::microseconds>(interval).count());
+  return std::max(interval_us, peak_us - peak_us / 256);
+}
+
+void Mixer::UpdateLatencyTarget()
+{
+  m_mix_interval_peak_us = UpdateIntervalPeak(m_mix_interval_peak_us, &m_last_mix_time);
+
+  float target_ms = static_cast<float>(SConfig::GetInstance().iTimingVariance);
+  if (Config::Get(Config::MAIN_AUDIO_ADAPTIVE_BUFFER))
+  {
+    // Between two callbacks, the FIFOs have to cover the longest measured gap between two
+    // callbacks and between two pushes of emulated audio.
+    target_ms = (m_mix_interval_peak_us + m_push_interval_peak_us.load()) / 1000.0f +
+                ADAPTIVE_LATENCY_MARGIN_MS;
+  }
+  m_target_latency_ms.store(target_ms);
+}
+
+Mixer::LatencyStatistics Mixer::GetLatencyStatistics() const
+{
+  return {m_dma_mixer.BufferedMilliseconds(), m_target_latency_ms.load(),
+          m_dma_mixer.GetUnderrunCount()};
+}
+
 void Mixer::SetDMAInputSampleRate(unsigned int rate)
 {
   m_dma_mixer.SetInputSampleRate(rate);
@@ -387,7 +556,14 @@ void Mixer::MixerFifo::SetVolume(unsigned int lvolume, unsigned int rvolume)
 unsigned int Mixer::MixerFifo::AvailableSamples() const
 {
   unsigned int samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
-  if (samples_in_fifo <= 1)
-    return 0;  // Mixer::MixerFifo::Mix always keeps one sample in the buffer.
-  return (samples_in_fifo - 1) * m_mixer->m_sampleRate / m_input_sample_rate;
+  // Mixer::MixerFifo::Mix keeps the samples the resampler looks ahead at in the buffer.
+  if (samples_in_fifo <= RESAMPLER_LOOKAHEAD)
+    return 0;
+  return (samples_in_fifo - RESAMPLER_LOOKAHEAD) * m_mixer->m_sampleRate / m_input_sample_rate;
+}
+
+float Mixer::MixerFifo::BufferedMilliseconds() const
+{
+  const u32 samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
+  return samples_in_fifo * 1000.0f / m_input_sample_rate;
 }
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 
 #include "AudioCommon/AudioStretcher.h"
 #include "AudioCommon/SurroundDecoder.h"
@@ -26,6 +27,11 @@ public:
   unsigned int Mix(short* samples, unsigned int numSamples);
   unsigned int MixSurround(float* samples, unsigned int num_samples);
 
+  // Called by the backends which output surround sound when their stream is created, before the
+  // first call to MixSurround. From then on, all stereo samples are mixed on the decoding thread.
+  void StartSurroundDecoder();
+  void StopSurroundDecoder();
+
   // Called from main thread
   void PushSamples(const short* samples, unsigned int num_samples);
   void PushStreamingSamples(const short* samples, unsigned int num_samples);
@@ -46,14 +52,53 @@ public:
   float GetCurrentSpeed() const { return m_speed.load(); }
   void UpdateSpeed(float val) { m_speed.store(val); }
 
-private:
+  struct LatencyStatistics
+  {
+    // Audio buffered in the DMA FIFO, in milliseconds.
+    float buffered_ms;
+    // Amount of audio the mixer tries to keep buffered in its FIFOs, in milliseconds.
+    float target_ms;
+    // Number of times the DMA FIFO ran dry while audio was playing.
+    u64 underruns;
+  };
+
+  // Can be called from any thread.
+  LatencyStatistics GetLatencyStatistics() const;
+
   static constexpr u32 MAX_SAMPLES = 1024 * 4;  // 128 ms
   static constexpr u32 INDEX_MASK = MAX_SAMPLES * 2 - 1;
+
+  // Polyphase windowed sinc filter used to resample the FIFOs. The filter reads
+  // RESAMPLER_TAPS / 2 sample pairs on each side of the read position.
+  static constexpr u32 RESAMPLER_TAPS = 8;
+  static constexpr u32 RESAMPLER_PHASES = 256;
+  static constexpr u32 RESAMPLER_HISTORY = RESAMPLER_TAPS / 2 - 1;
+  static constexpr u32 RESAMPLER_LOOKAHEAD = RESAMPLER_TAPS / 2;
+
+  struct ResamplerPhase
+  {
+    // One coefficient per sample pair, in 1.14 fixed point.
+    std::array<s16, RESAMPLER_TAPS> taps;
+    // The same coefficients as pairs repeated for both channels (c0 c1 c0 c1 c2 c3 c2 c3 ...).
+    alignas(16) std::array<s16, RESAMPLER_TAPS * 2> paired_taps;
+  };
+
+  static const std::array<ResamplerPhase, RESAMPLER_PHASES>& GetResamplerFilter();
+
+  // Applies a phase of the filter to the RESAMPLER_TAPS pairs of big endian samples that start at
+  // index first of a FIFO buffer, and returns the unscaled sums of both channels.
+  static void ApplyResampler(const std::array<short, MAX_SAMPLES * 2>& buffer, u32 first,
+                             const ResamplerPhase& phase, int* left, int* right);
+
+private:
   static constexpr int MAX_FREQ_SHIFT = 200;  // Per 32000 Hz
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
 
-  const unsigned int SURROUND_CHANNELS = 6;
+  // Intervals longer than this between two callbacks or two pushes are treated as pauses and
+  // ignored by the adaptive latency target.
+  static constexpr std::chrono::microseconds MAX_TRACKED_INTERVAL{100000};
+  static constexpr float ADAPTIVE_LATENCY_MARGIN_MS = 2.0f;
 
   class MixerFifo final
   {
@@ -68,6 +113,8 @@ private:
     unsigned int GetInputSampleRate() const;
     void SetVolume(unsigned int lvolume, unsigned int rvolume);
     unsigned int AvailableSamples() const;
+    float BufferedMilliseconds() const;
+    u64 GetUnderrunCount() const { return m_underruns.load(); }
 
   private:
     Mixer* m_mixer;
@@ -80,8 +127,14 @@ private:
     std::atomic<s32> m_RVolume{256};
     float m_numLeftI = 0.0f;
     u32 m_frac = 0;
+    std::atomic<u64> m_underruns{0};
+    bool m_starved = true;
   };
 
+  static u32 UpdateIntervalPeak(u32 peak_us, std::chrono::steady_clock::time_point* last_time);
+  void UpdateLatencyTarget();
+  void MixStereo(short* samples, unsigned int num_samples);
+
   MixerFifo m_dma_mixer{this, 32000};
   MixerFifo m_streaming_mixer{this, 48000};
   MixerFifo m_wiimote_speaker_mixer{this, 3000};
@@ -100,4 +153,12 @@ private:
 
   // Current rate of emulation (1.0 = 100% speed)
   std::atomic<float> m_speed{0.0f};
+
+  // Decaying peaks of the intervals between two backend callbacks and between two pushes of DMA
+  // samples, used to size the FIFOs when the adaptive buffer is enabled.
+  std::chrono::steady_clock::time_point m_last_mix_time{};
+  std::chrono::steady_clock::time_point m_last_push_time{};
+  u32 m_mix_interval_peak_us = 0;
+  std::atomic<u32> m_push_interval_peak_us{0};
+  std::atomic<float> m_target_latency_ms{0.0f};
 };
@@ -271,6 +271,9 @@ void OpenALStream::SoundLoop()
   // TODO: Error handling
   // ALenum err = alGetError();
 
+  if (use_surround)
+    m_mixer->StartSurroundDecoder();
+
   unsigned int next_buffer = 0;
   unsigned int num_buffers_queued = 0;
   ALint state = 0;
@@ -355,6 +358,7 @@ void OpenALStream::SoundLoop()
         WARN_LOG_FMT(
             AUDIO, "Unable to set 5.1 surround mode.  Updating OpenAL Soft might fix this issue.");
         use_surround = false;
+        m_mixer->StopSurroundDecoder();
       }
     }
     else
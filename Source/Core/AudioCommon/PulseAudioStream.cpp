@@ -127,6 +127,10 @@ bool PulseAudio::PulseInit()
     return false;
   }
 
+  // The write callback only runs from pa_mainloop_iterate, so this is before the first one.
+  if (!m_stereo)
+    m_mixer->StartSurroundDecoder();
+
   INFO_LOG_FMT(AUDIO, "Pulse successfully initialized");
   return true;
 }
@@ -3,91 +3,152 @@
 // Refer to the license.txt file included.
 
 #include <FreeSurround/FreeSurroundDecoder.h>
+#include <algorithm>
 #include <limits>
 
 #include "AudioCommon/SurroundDecoder.h"
+#include "Common/Thread.h"
 
 namespace AudioCommon
 {
 constexpr size_t STEREO_CHANNELS = 2;
-constexpr size_t SURROUND_CHANNELS = 6;
+
+void SurroundFrameRing::Reset()
+{
+  m_write_index.store(0);
+  m_read_index.store(0);
+}
+
+float* SurroundFrameRing::GetWriteFrame(u32 index)
+{
+  return &m_buffer[((m_write_index.load() + index) & (CAPACITY_FRAMES - 1)) * CHANNELS];
+}
+
+void SurroundFrameRing::CommitFrames(u32 num_frames)
+{
+  m_write_index.store(m_write_index.load() + num_frames);
+}
+
+size_t SurroundFrameRing::ReadFrames(float* out, size_t num_frames)
+{
+  const u32 read_index = m_read_index.load();
+  const size_t available_frames = std::min<size_t>(m_write_index.load() - read_index, num_frames);
+
+  // Copy to output array, in up to two parts as the ring buffer may wrap around
+  const u32 start = read_index & (CAPACITY_FRAMES - 1);
+  const size_t first_frames = std::min<size_t>(available_frames, CAPACITY_FRAMES - start);
+  std::copy_n(&m_buffer[start * CHANNELS], first_frames * CHANNELS, out);
+  std::copy_n(m_buffer.data(), (available_frames - first_frames) * CHANNELS,
+              out + first_frames * CHANNELS);
+  std::fill(out + available_frames * CHANNELS, out + num_frames * CHANNELS, 0.0f);
+
+  m_read_index.store(read_index + static_cast<u32>(available_frames));
+  return available_frames;
+}
 
 SurroundDecoder::SurroundDecoder(u32 sample_rate, u32 frame_block_size)
-    : m_sample_rate(sample_rate), m_frame_block_size(frame_block_size)
+    : m_sample_rate(sample_rate), m_frame_block_size(frame_block_size),
+      m_source_buffer(frame_block_size * STEREO_CHANNELS),
+      m_float_conversion_buffer(frame_block_size * STEREO_CHANNELS)
 {
   m_fsdecoder = std::make_unique<DPL2FSDecoder>();
   m_fsdecoder->Init(cs_5point1, m_frame_block_size, m_sample_rate);
 }
 
-SurroundDecoder::~SurroundDecoder() = default;
+SurroundDecoder::~SurroundDecoder()
+{
+  Stop();
+}
 
-void SurroundDecoder::Clear()
+void SurroundDecoder::Start(SourceFunction source)
 {
+  Stop();
+
   m_fsdecoder->flush();
-  m_decoded_fifo.clear();
+  m_decoded_frames.Reset();
+  m_source = std::move(source);
+  m_running.store(true);
+  m_thread = std::thread(&SurroundDecoder::ThreadLoop, this);
 }
 
-// Currently only 6 channels are supported.
-size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_frames) const
+void SurroundDecoder::Stop()
 {
-  if (m_decoded_fifo.size() < output_frames * SURROUND_CHANNELS)
-  {
-    // Output stereo frames needed to have at least the desired number of surround frames
-    size_t frames_needed = output_frames - m_decoded_fifo.size() / SURROUND_CHANNELS;
-    return frames_needed + m_frame_block_size - frames_needed % m_frame_block_size;
-  }
+  if (!m_thread.joinable())
+    return;
 
-  return 0;
+  m_running.store(false);
+  m_wake_event.Set();
+  m_thread.join();
 }
 
-// Receive and decode samples
-void SurroundDecoder::PutFrames(const short* in, const size_t num_frames_in)
+void SurroundDecoder::ThreadLoop()
 {
-  // Maybe check if it is really power-of-2?
-  s64 remaining_frames = static_cast<s64>(num_frames_in);
-  size_t frame_index = 0;
+  Common::SetCurrentThreadName("Surround decoder");
 
-  while (remaining_frames > 0)
+  while (m_running.load())
   {
-    // Convert to float
-    for (size_t i = 0, end = m_frame_block_size * STEREO_CHANNELS; i < end; ++i)
+    // Stay one block ahead of what the consumer asks for at once, so that a request can always be
+    // served from frames which have already been decoded.
+    const u32 target_frames = std::min(m_requested_frames.load() + m_frame_block_size,
+                                       SurroundFrameRing::CAPACITY_FRAMES);
+    while (m_running.load())
     {
-      m_float_conversion_buffer[i] = in[i + frame_index * STEREO_CHANNELS] /
-                                     static_cast<float>(std::numeric_limits<short>::max());
+      if (m_decoded_frames.GetAvailableFrames() >= target_frames ||
+          m_decoded_frames.GetFreeFrames() < m_frame_block_size)
+      {
+        break;
+      }
+      DecodeBlock();
     }
 
-    // Decode
-    const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
-
-    // Add to ring buffer and fix channel mapping
-    // Maybe modify FreeSurround to output the correct mapping?
-    // FreeSurround:
-    // FL | FC | FR | BL | BR | LFE
-    // Most backends:
-    // FL | FR | FC | LFE | BL | BR
-    for (size_t i = 0; i < m_frame_block_size; ++i)
-    {
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 0]);  // LEFTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 2]);  // RIGHTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 1]);  // CENTREFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 5]);  // sub/lfe
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 3]);  // LEFTREAR
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 4]);  // RIGHTREAR
-    }
-
-    remaining_frames = remaining_frames - static_cast<int>(m_frame_block_size);
-    frame_index = frame_index + m_frame_block_size;
+    m_wake_event.Wait();
   }
 }
 
-void SurroundDecoder::ReceiveFrames(float* out, const size_t num_frames_out)
+// Receive and decode one block of samples
+void SurroundDecoder::DecodeBlock()
 {
-  // Copy to output array with desired num_frames_out
-  for (size_t i = 0, num_samples_output = num_frames_out * SURROUND_CHANNELS;
-       i < num_samples_output; ++i)
+  m_source(m_source_buffer.data(), m_frame_block_size);
+
+  // Convert to float
+  for (size_t i = 0; i < m_source_buffer.size(); ++i)
   {
-    out[i] = m_decoded_fifo.pop_front();
+    m_float_conversion_buffer[i] =
+        m_source_buffer[i] / static_cast<float>(std::numeric_limits<short>::max());
   }
+
+  // Decode
+  const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
+
+  // Add to ring buffer and fix channel mapping
+  // Maybe modify FreeSurround to output the correct mapping?
+  // FreeSurround:
+  // FL | FC | FR | BL | BR | LFE
+  // Most backends:
+  // FL | FR | FC | LFE | BL | BR
+  for (u32 i = 0; i < m_frame_block_size; ++i)
+  {
+    const float* in = &dpl2_fs[i * SURROUND_CHANNELS];
+    float* out = m_decoded_frames.GetWriteFrame(i);
+    out[0] = in[0];  // LEFTFRONT
+    out[1] = in[2];  // RIGHTFRONT
+    out[2] = in[1];  // CENTREFRONT
+    out[3] = in[5];  // sub/lfe
+    out[4] = in[3];  // LEFTREAR
+    out[5] = in[4];  // RIGHTREAR
+  }
+
+  m_decoded_frames.CommitFrames(m_frame_block_size);
+}
+
+size_t SurroundDecoder::ReceiveFrames(float* out, const size_t num_frames_out)
+{
+  m_requested_frames.store(static_cast<u32>(num_frames_out));
+
+  const size_t available_frames = m_decoded_frames.ReadFrames(out, num_frames_out);
+  m_wake_event.Set();
+
+  return available_frames;
 }
 
 }  // namespace AudioCommon
@@ -5,32 +5,92 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
-#include "Common/FixedSizeQueue.h"
+#include "Common/Event.h"
 
 class DPL2FSDecoder;
 
 namespace AudioCommon
 {
+// Single producer, single consumer ring buffer of 5.1 frames. The indices count frames and wrap
+// around at 2^32.
+class SurroundFrameRing
+{
+public:
+  static constexpr size_t CHANNELS = 6;
+  // Must be a power of two.
+  static constexpr u32 CAPACITY_FRAMES = 16384;
+
+  // Must not be called while either side is using the ring.
+  void Reset();
+
+  u32 GetAvailableFrames() const { return m_write_index.load() - m_read_index.load(); }
+  u32 GetFreeFrames() const { return CAPACITY_FRAMES - GetAvailableFrames(); }
+
+  // Producer side. Returns the frame index frames after the last committed one, which becomes
+  // visible to the consumer once CommitFrames has been called. index must be below GetFreeFrames.
+  float* GetWriteFrame(u32 index);
+  void CommitFrames(u32 num_frames);
+
+  // Consumer side. Copies up to num_frames frames to out and fills the rest with silence.
+  // Returns the number of frames which were copied.
+  size_t ReadFrames(float* out, size_t num_frames);
+
+private:
+  std::array<float, CAPACITY_FRAMES * CHANNELS> m_buffer{};
+  std::atomic<u32> m_write_index{0};
+  std::atomic<u32> m_read_index{0};
+};
+
+// Decodes stereo audio to 5.1 on a thread of its own, so that the audio callbacks only have to
+// copy frames which have already been decoded.
 class SurroundDecoder
 {
 public:
+  // Called on the decoding thread to get the next num_frames stereo frames to decode.
+  using SourceFunction = std::function<void(short* samples, u32 num_frames)>;
+
+  static constexpr size_t SURROUND_CHANNELS = SurroundFrameRing::CHANNELS;
+
   explicit SurroundDecoder(u32 sample_rate, u32 frame_block_size);
   ~SurroundDecoder();
-  size_t QueryFramesNeededForSurroundOutput(const size_t output_frames) const;
-  void PutFrames(const short* in, const size_t num_frames_in);
-  void ReceiveFrames(float* out, const size_t num_frames_out);
-  void Clear();
+
+  SurroundDecoder(const SurroundDecoder&) = delete;
+  SurroundDecoder& operator=(const SurroundDecoder&) = delete;
+
+  void Start(SourceFunction source);
+  void Stop();
+  bool IsRunning() const { return m_running.load(); }
+
+  // Copies num_frames_out decoded frames to out without waiting for the decoding thread. The frames
+  // which haven't been decoded yet are filled with silence. Returns the number of decoded frames.
+  size_t ReceiveFrames(float* out, size_t num_frames_out);
 
 private:
+  void ThreadLoop();
+  void DecodeBlock();
+
   u32 m_sample_rate;
   u32 m_frame_block_size;
 
   std::unique_ptr<DPL2FSDecoder> m_fsdecoder;
-  std::array<float, 32768> m_float_conversion_buffer;
-  FixedSizeQueue<float, 32768> m_decoded_fifo;
+  SourceFunction m_source;
+  std::vector<short> m_source_buffer;
+  std::vector<float> m_float_conversion_buffer;
+
+  std::thread m_thread;
+  Common::Event m_wake_event;
+  std::atomic<bool> m_running{false};
+
+  SurroundFrameRing m_decoded_frames;
+  // Size of the last request of the consumer, which the decoding thread tries to stay ahead of.
+  std::atomic<u32> m_requested_frames{0};
 };
 
 }  // namespace AudioCommon
@@ -118,8 +118,10 @@ extern PFNDOLDRAWARRAYSINSTANCEDPROC dolDrawArraysInstanced;
 extern PFNDOLDRAWELEMENTSINSTANCEDPROC dolDrawElementsInstanced;
 extern PFNDOLPRIMITIVERESTARTINDEXPROC dolPrimitiveRestartIndex;
 extern PFNDOLTEXBUFFERPROC dolTexBuffer;
+extern PFNDOLCOPYBUFFERSUBDATAPROC dolCopyBufferSubData;
 
 #define glDrawArraysInstanced dolDrawArraysInstanced
 #define glDrawElementsInstanced dolDrawElementsInstanced
 #define glPrimitiveRestartIndex dolPrimitiveRestartIndex
 #define glTexBuffer dolTexBuffer
+#define glCopyBufferSubData dolCopyBufferSubData
@@ -1859,12 +1859,11 @@ static int GetVEXpp(u8 opPrefix)
 }
 
 void XEmitter::WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
-                          int W, int extrabytes)
+                          int W, int extrabytes, int L)
 {
   int mmmmm = GetVEXmmmmm(op);
   int pp = GetVEXpp(opPrefix);
-  // FIXME: we currently don't support 256-bit instructions, and "size" is not the vector size here
-  arg.WriteVEX(this, regOp1, regOp2, 0, pp, mmmmm, W);
+  arg.WriteVEX(this, regOp1, regOp2, L, pp, mmmmm, W);
   Write8(op & 0xFF);
   arg.WriteRest(this, extrabytes, regOp1);
 }
@@ -1877,11 +1876,19 @@ void XEmitter::WriteVEXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, co
 }
 
 void XEmitter::WriteAVXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
-                          int W, int extrabytes)
+                          int W, int extrabytes, int L)
 {
   if (!cpu_info.bAVX)
     PanicAlertFmt("Trying to use AVX on a system that doesn't support it. Bad programmer.");
-  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, W, extrabytes);
+  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, W, extrabytes, L);
+}
+
+void XEmitter::WriteAVX2Op(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
+                           int W, int extrabytes, int L)
+{
+  if (!cpu_info.bAVX2)
+    PanicAlertFmt("Trying to use AVX2 on a system that doesn't support it. Bad programmer.");
+  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, W, extrabytes, L);
 }
 
 void XEmitter::WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
@@ -3048,6 +3055,110 @@ void XEmitter::VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
   WriteAVXOp(0x66, 0xEF, regOp1, regOp2, arg);
 }
 
+void XEmitter::VMOVD_xmm(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0x66, 0x6E, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVQ_xmm(X64Reg dest, const OpArg& arg)
+{
+  // Same encoding as MOVQ_xmm, so that general purpose registers work as well.
+  WriteAVXOp(0x66, 0x6E, dest, INVALID_REG, arg, 1);
+}
+void XEmitter::VMOVDQU(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, 0x6F, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVSS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0xF3, 0x11, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVLPS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0x00, 0x13, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVUPS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0x00, 0x11, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVHLPS(X64Reg regOp1, X64Reg regOp2, X64Reg regOp3)
+{
+  WriteAVXOp(0x00, 0x12, regOp1, regOp2, R(regOp3));
+}
+void XEmitter::VCVTSI2SS(int size, X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, 0x2A, regOp1, regOp2, arg, size == 64);
+}
+
+static int GetVEXL(int size)
+{
+  ASSERT_MSG(DYNA_REC, size == 128 || size == 256, "Invalid vector size: %d", size);
+  return size == 256;
+}
+
+void XEmitter::VMULPS(int size, X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVXOp(0x00, sseMUL, regOp1, regOp2, arg, 0, 0, GetVEXL(size));
+}
+void XEmitter::VCVTDQ2PS(int size, X64Reg regOp1, const OpArg& arg)
+{
+  WriteAVXOp(0x00, 0x5B, regOp1, INVALID_REG, arg, 0, 0, GetVEXL(size));
+}
+void XEmitter::VBROADCASTSS(int size, X64Reg regOp1, const OpArg& arg)
+{
+  if (arg.IsSimpleReg())
+    WriteAVX2Op(0x66, 0x3818, regOp1, INVALID_REG, arg, 0, 0, GetVEXL(size));
+  else
+    WriteAVXOp(0x66, 0x3818, regOp1, INVALID_REG, arg, 0, 0, GetVEXL(size));
+}
+void XEmitter::VPSHUFB(int size, X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  if (size == 256)
+    WriteAVX2Op(0x66, 0x3800, regOp1, regOp2, arg, 0, 0, 1);
+  else
+    WriteAVXOp(0x66, 0x3800, regOp1, regOp2, arg, 0, 0, GetVEXL(size));
+}
+void XEmitter::VPSRAD(int size, X64Reg regOp1, X64Reg regOp2, u8 shift)
+{
+  if (size == 256)
+    WriteAVX2Op(0x66, 0x72, (X64Reg)4, regOp1, R(regOp2), 0, 1, 1);
+  else
+    WriteAVXOp(0x66, 0x72, (X64Reg)4, regOp1, R(regOp2), 0, 1, GetVEXL(size));
+  Write8(shift);
+}
+void XEmitter::VPSRLD(int size, X64Reg regOp1, X64Reg regOp2, u8 shift)
+{
+  if (size == 256)
+    WriteAVX2Op(0x66, 0x72, (X64Reg)2, regOp1, R(regOp2), 0, 1, 1);
+  else
+    WriteAVXOp(0x66, 0x72, (X64Reg)2, regOp1, R(regOp2), 0, 1, GetVEXL(size));
+  Write8(shift);
+}
+
+void XEmitter::VBROADCASTI128(X64Reg regOp1, const OpArg& arg)
+{
+  if (arg.IsSimpleReg())
+    PanicAlertFmt("VBROADCASTI128 only supports a memory operand.");
+  WriteAVX2Op(0x66, 0x385A, regOp1, INVALID_REG, arg, 0, 0, 1);
+}
+void XEmitter::VINSERTI128(X64Reg regOp1, X64Reg regOp2, const OpArg& arg, u8 select)
+{
+  WriteAVX2Op(0x66, 0x3A38, regOp1, regOp2, arg, 0, 1, 1);
+  Write8(select);
+}
+void XEmitter::VEXTRACTI128(const OpArg& arg, X64Reg regOp1, u8 select)
+{
+  WriteAVX2Op(0x66, 0x3A39, regOp1, INVALID_REG, arg, 0, 1, 1);
+  Write8(select);
+}
+void XEmitter::VZEROUPPER()
+{
+  if (!cpu_info.bAVX)
+    PanicAlertFmt("Trying to use AVX on a system that doesn't support it. Bad programmer.");
+  Write8(0xC5);
+  Write8(0xF8);
+  Write8(0x77);
+}
+
 void XEmitter::VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
 {
   WriteFMA3Op(0x98, regOp1, regOp2, arg);
@@ -358,11 +358,13 @@ private:
   void WriteSSSE3Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteSSE41Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
-                  int extrabytes = 0);
+                  int extrabytes = 0, int L = 0);
   void WriteVEXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
   void WriteAVXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
-                  int extrabytes = 0);
+                  int extrabytes = 0, int L = 0);
+  void WriteAVX2Op(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
+                   int extrabytes = 0, int L = 0);
   void WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
   void WriteFMA3Op(u8 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0);
@@ -898,6 +900,30 @@ public:
   void VPOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
 
+  // AVX: 128-bit moves and conversions. The stores only support memory destinations.
+  void VMOVD_xmm(X64Reg dest, const OpArg& arg);
+  void VMOVQ_xmm(X64Reg dest, const OpArg& arg);
+  void VMOVDQU(X64Reg dest, const OpArg& arg);
+  void VMOVSS(const OpArg& arg, X64Reg src);
+  void VMOVLPS(const OpArg& arg, X64Reg src);
+  void VMOVUPS(const OpArg& arg, X64Reg src);
+  void VMOVHLPS(X64Reg regOp1, X64Reg regOp2, X64Reg regOp3);
+  void VCVTSI2SS(int size, X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+
+  // AVX/AVX2 with a selectable vector size (128 or 256 bits)
+  void VMULPS(int size, X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VCVTDQ2PS(int size, X64Reg regOp1, const OpArg& arg);
+  void VBROADCASTSS(int size, X64Reg regOp1, const OpArg& arg);
+  void VPSHUFB(int size, X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VPSRAD(int size, X64Reg regOp1, X64Reg regOp2, u8 shift);
+  void VPSRLD(int size, X64Reg regOp1, X64Reg regOp2, u8 shift);
+
+  // AVX2: 128-bit lane operations on 256-bit registers
+  void VBROADCASTI128(X64Reg regOp1, const OpArg& arg);
+  void VINSERTI128(X64Reg regOp1, X64Reg regOp2, const OpArg& arg, u8 select);
+  void VEXTRACTI128(const OpArg& arg, X64Reg regOp1, u8 select);
+  void VZEROUPPER();
+
   // FMA3
   void VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VFMADD213PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
@@ -48,6 +48,10 @@ const Info<std::string> GFX_DUMP_CODEC{{System::GFX, "Settings", "DumpCodec"}, "
 const Info<std::string> GFX_DUMP_ENCODER{{System::GFX, "Settings", "DumpEncoder"}, ""};
 const Info<std::string> GFX_DUMP_PATH{{System::GFX, "Settings", "DumpPath"}, ""};
 const Info<int> GFX_BITRATE_KBPS{{System::GFX, "Settings", "BitrateKbps"}, 25000};
+const Info<int> GFX_FRAME_DUMPS_QUEUE_SIZE{{System::GFX, "Settings", "FrameDumpsQueueSize"}, 8};
+const Info<int> GFX_FRAME_DUMPS_THREADS{{System::GFX, "Settings", "FrameDumpsThreads"}, 0};
+const Info<bool> GFX_FRAME_DUMPS_DROP_WHEN_FULL{{System::GFX, "Settings", "FrameDumpsDropWhenFull"},
+                                                false};
 const Info<bool> GFX_INTERNAL_RESOLUTION_FRAME_DUMPS{
     {System::GFX, "Settings", "InternalResolutionFrameDumps"}, false};
 const Info<bool> GFX_ENABLE_GPU_TEXTURE_DECODING{
@@ -98,6 +102,7 @@ const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES{{System::GFX, "Settings", "SWDumpTe
                                              false};
 const Info<int> GFX_SW_DRAW_START{{System::GFX, "Settings", "SWDrawStart"}, 0};
 const Info<int> GFX_SW_DRAW_END{{System::GFX, "Settings", "SWDrawEnd"}, 100000};
+const Info<int> GFX_SW_RASTERIZER_THREADS{{System::GFX, "Settings", "SWRasterizerThreads"}, -1};
 
 const Info<bool> GFX_PREFER_GLES{{System::GFX, "Settings", "PreferGLES"}, false};
 
@@ -136,7 +141,11 @@ const Info<bool> GFX_HACK_EFB_ACCESS_ENABLE{{System::GFX, "Hacks", "EFBAccessEna
 const Info<bool> GFX_HACK_EFB_DEFER_INVALIDATION{
     {System::GFX, "Hacks", "EFBAccessDeferInvalidation"}, false};
 const Info<int> GFX_HACK_EFB_ACCESS_TILE_SIZE{{System::GFX, "Hacks", "EFBAccessTileSize"}, 64};
+const Info<bool> GFX_HACK_EFB_ACCESS_PREFETCH{{System::GFX, "Hacks", "EFBAccessPrefetch"}, true};
+const Info<bool> GFX_HACK_EFB_ACCESS_ONE_FRAME_LATE{{System::GFX, "Hacks", "EFBAccessOneFrameLate"},
+                                                    false};
 const Info<bool> GFX_HACK_BBOX_ENABLE{{System::GFX, "Hacks", "BBoxEnable"}, false};
+const Info<bool> GFX_HACK_BBOX_DEFERRED{{System::GFX, "Hacks", "BBoxDeferred"}, false};
 const Info<bool> GFX_HACK_FORCE_PROGRESSIVE{{System::GFX, "Hacks", "ForceProgressive"}, true};
 const Info<bool> GFX_HACK_SKIP_EFB_COPY_TO_RAM{{System::GFX, "Hacks", "EFBToTextureEnable"}, true};
 const Info<bool> GFX_HACK_SKIP_XFB_COPY_TO_RAM{{System::GFX, "Hacks", "XFBToTextureEnable"}, true};
@@ -60,6 +60,7 @@ public:
     layer->Set(Config::MAIN_SYNC_GPU_MAX_DISTANCE, m_settings.m_SyncGpuMaxDistance);
     layer->Set(Config::MAIN_SYNC_GPU_MIN_DISTANCE, m_settings.m_SyncGpuMinDistance);
     layer->Set(Config::MAIN_SYNC_GPU_OVERCLOCK, m_settings.m_SyncGpuOverclock);
+    layer->Set(Config::MAIN_SYNC_GPU_ADAPTIVE, false);
     layer->Set(Config::MAIN_JIT_FOLLOW_BRANCH, m_settings.m_JITFollowBranch);
     layer->Set(Config::MAIN_FAST_DISC_SPEED, m_settings.m_FastDiscSpeed);
     layer->Set(Config::MAIN_MMU, m_settings.m_MMU);
@@ -69,6 +70,9 @@ public:
     layer->Set(Config::GFX_HACK_DEFER_EFB_COPIES, m_settings.m_DeferEFBCopies);
     layer->Set(Config::GFX_HACK_EFB_ACCESS_TILE_SIZE, m_settings.m_EFBAccessTileSize);
     layer->Set(Config::GFX_HACK_EFB_DEFER_INVALIDATION, m_settings.m_EFBAccessDeferInvalidation);
+    // Stale peeks depend on host timing, which would desync the clients.
+    layer->Set(Config::GFX_HACK_EFB_ACCESS_ONE_FRAME_LATE, false);
+    layer->Set(Config::GFX_HACK_BBOX_DEFERRED, false);
 
     if (m_settings.m_StrictSettingsSync)
     {
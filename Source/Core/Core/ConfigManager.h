@@ -139,6 +139,7 @@ struct SConfig
   int iSyncGpuMaxDistance;
   int iSyncGpuMinDistance;
   float fSyncGpuOverclock;
+  bool bSyncGPUAdaptive;
 
   int SelectedLanguage = 0;
   bool bOverrideRegionSettings = false;
@@ -12,6 +12,18 @@
 
 namespace DSP
 {
+namespace
+{
+s16 DecodeADPCMNibble(int nibble, int scale, s32 coef1, s32 coef2, s16 yn1, s16 yn2)
+{
+  if (nibble >= 8)
+    nibble -= 16;
+
+  const s32 val32 = (scale * nibble) + ((0x400 + coef1 * yn1 + coef2 * yn2) >> 11);
+  return static_cast<s16>(std::clamp<s32>(val32, -0x7FFF, 0x7FFF));
+}
+}  // Anonymous namespace
+
 u16 Accelerator::ReadD3()
 {
   u16 val = 0;
@@ -86,11 +98,7 @@ u16 Accelerator::Read(const s16* coefs)
     int temp = (m_current_address & 1) ? (ReadMemory(m_current_address >> 1) & 0xF) :
                                          (ReadMemory(m_current_address >> 1) >> 4);
 
-    if (temp >= 8)
-      temp -= 16;
-
-    s32 val32 = (scale * temp) + ((0x400 + coef1 * m_yn1 + coef2 * m_yn2) >> 11);
-    val = static_cast<s16>(std::clamp<s32>(val32, -0x7FFF, 0x7FFF));
+    val = DecodeADPCMNibble(temp, scale, coef1, coef2, m_yn1, m_yn2);
     step_size_bytes = 2;
 
     m_yn2 = m_yn1;
@@ -161,6 +169,52 @@ u16 Accelerator::Read(const s16* coefs)
   return val;
 }
 
+void Accelerator::ReadSamples(const s16* coefs, s16* samples, u32 count)
+{
+  u32 i = 0;
+  while (i < count)
+  {
+    u32 frame_count = 0;
+    if (m_sample_format == 0x00 && !m_reads_stopped)
+    {
+      // Decode the samples up to the last one of the ADPCM frame, which loads the header of the
+      // next frame and is left to Read(). None of them may reach the end address, as that would
+      // trigger the looping and exception handling of Read().
+      frame_count = std::min<u32>(count - i, 15 - (m_current_address & 15));
+      const u64 first_address = u64{m_current_address} + 1;
+      const u64 last_address = u64{m_current_address} + frame_count;
+      if (u64{m_end_address} + 1 >= first_address && m_end_address <= last_address + 1)
+        frame_count = 0;
+    }
+
+    if (frame_count == 0)
+    {
+      samples[i++] = static_cast<s16>(Read(coefs));
+      continue;
+    }
+
+    const int scale = 1 << (m_pred_scale & 0xF);
+    const int coef_idx = (m_pred_scale >> 4) & 0x7;
+    const s32 coef1 = coefs[coef_idx * 2 + 0];
+    const s32 coef2 = coefs[coef_idx * 2 + 1];
+
+    u8 byte = ReadMemory(m_current_address >> 1);
+    for (u32 j = 0; j < frame_count; ++j)
+    {
+      if (j != 0 && (m_current_address & 1) == 0)
+        byte = ReadMemory(m_current_address >> 1);
+
+      const int nibble = (m_current_address & 1) ? (byte & 0xF) : (byte >> 4);
+      const s16 val = DecodeADPCMNibble(nibble, scale, coef1, coef2, m_yn1, m_yn2);
+      m_yn2 = m_yn1;
+      m_yn1 = val;
+      m_current_address += 1;
+      samples[i++] = val;
+    }
+    SetCurrentAddress(m_current_address);
+  }
+}
+
 void Accelerator::DoState(PointerWrap& p)
 {
   p.Do(m_start_address);
@@ -16,6 +16,9 @@ public:
   virtual ~Accelerator() = default;
 
   u16 Read(const s16* coefs);
+  // Reads count samples, with the same results as calling Read() count times. ADPCM samples are
+  // decoded a frame at a time, reading each byte of the frame once.
+  void ReadSamples(const s16* coefs, s16* samples, u32 count);
   // Zelda ucode reads ARAM through 0xffd3.
   u16 ReadD3();
   void WriteD3(u16 value);
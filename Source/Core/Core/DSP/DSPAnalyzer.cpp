@@ -84,6 +84,7 @@ void Analyzer::AnalyzeRange(const SDSP& dsp, u16 start_addr, u16 end_addr)
 
   // Next, we'll scan for potential idle skips.
   FindIdleSkips(dsp, start_addr, end_addr);
+  FindPollingLoops(dsp, start_addr, end_addr);
 
   INFO_LOG_FMT(DSPLLE, "Finished analysis.");
 }
@@ -167,4 +168,67 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
     }
   }
 }
+
+void Analyzer::FindPollingLoops(const SDSP& dsp, u16 start_addr, u16 end_addr)
+{
+  // Looks for the following loop, where the mailbox is either DMBH or CMBH:
+  //   loop: LRS/LR $acX.m, @mailbox
+  //         ANDF/ANDCF $acX.m, #mask
+  //         Jcc loop
+  // Nothing but the mailbox can change the outcome of the test, so the DSP may as well give up
+  // its time slice until the CPU has had a chance to read or write the mail.
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    if (!IsStartOfInstruction(addr))
+      continue;
+
+    const UDSPInstruction load = dsp.ReadIMEM(addr);
+    u16 reg;
+    u16 mailbox;
+    u16 load_size;
+    if ((load & 0xf800) == 0x2000)
+    {
+      // LRS $(0x18+D), @M
+      reg = 0x18 + ((load >> 8) & 0x7);
+      mailbox = 0xff00 | (load & 0xff);
+      load_size = 1;
+    }
+    else if ((load & 0xffe0) == 0x00c0)
+    {
+      // LR $D, @M
+      reg = load & 0x1f;
+      mailbox = dsp.ReadIMEM(static_cast<u16>(addr + 1));
+      load_size = 2;
+    }
+    else
+    {
+      continue;
+    }
+
+    if (mailbox != (0xff00 | DSP_DMBH) && mailbox != (0xff00 | DSP_CMBH))
+      continue;
+
+    // ANDF and ANDCF only test the middle part of an accumulator.
+    const u16 test_addr = static_cast<u16>(addr + load_size);
+    const UDSPInstruction test = dsp.ReadIMEM(test_addr);
+    if ((test & 0xfeff) != 0x02a0 && (test & 0xfeff) != 0x02c0)
+      continue;
+    if (reg != DSP_REG_ACM0 + ((test >> 8) & 0x1))
+      continue;
+
+    // Any conditional jump back to the load; 0x029f is the unconditional JMP.
+    const u16 jump_addr = static_cast<u16>(test_addr + 2);
+    const UDSPInstruction jump = dsp.ReadIMEM(jump_addr);
+    if ((jump & 0xfff0) != 0x0290 || (jump & 0xf) == 0xf)
+      continue;
+    if (dsp.ReadIMEM(static_cast<u16>(jump_addr + 1)) != addr)
+      continue;
+
+    if (!IsIdleSkip(addr))
+    {
+      INFO_LOG_FMT(DSPLLE, "Mailbox polling loop found at {:04x}", addr);
+      m_code_flags[addr] |= CODE_IDLE_SKIP;
+    }
+  }
+}
 }  // namespace DSP
@@ -100,6 +100,11 @@ private:
   // Finds locations within the range [start_addr, end_addr) that may contain idle skips.
   void FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr);
 
+  // Finds loops within the range [start_addr, end_addr) that only wait for a mailbox to change
+  // state, and marks them as idle skips. This catches the wait loops of ucodes that use registers
+  // or jump conditions the idle skip signatures don't cover.
+  void FindPollingLoops(const SDSP& dsp, u16 start_addr, u16 end_addr);
+
   // Retrieves the flags set during analysis for code in memory.
   [[nodiscard]] u8 GetCodeFlags(u16 address) const { return m_code_flags[address]; }
 
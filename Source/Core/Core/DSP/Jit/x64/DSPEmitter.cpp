@@ -8,6 +8,8 @@
 #include <cstddef>
 #include <cstring>
 
+#include <xxhash.h>
+
 #include "Common/Assert.h"
 #include "Common/BitSet.h"
 #include "Common/ChunkFile.h"
@@ -26,13 +28,16 @@ using namespace Gen;
 
 namespace DSP::JIT::x64
 {
-constexpr size_t COMPILED_CODE_SIZE = 2097152;
+// Half of the code space is kept free for the ucode which is running, the rest holds the code of
+// cached ucode images.
+constexpr size_t COMPILED_CODE_SIZE = 4194304;
 constexpr size_t MAX_BLOCK_SIZE = 250;
 constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
 
 DSPEmitter::DSPEmitter(DSPCore& dsp)
     : m_compile_status_register{SR_INT_ENABLE | SR_EXT_INT_ENABLE}, m_blocks(MAX_BLOCKS),
-      m_block_size(MAX_BLOCKS), m_block_links(MAX_BLOCKS), m_dsp_core{dsp}
+      m_block_size(MAX_BLOCKS), m_block_links(MAX_BLOCKS), m_unresolved_jumps(MAX_BLOCKS),
+      m_dsp_core{dsp}
 {
   x64::InitInstructionTables();
   AllocCodeSpace(COMPILED_CODE_SIZE);
@@ -58,13 +63,15 @@ u16 DSPEmitter::RunCycles(u16 cycles)
     m_dsp_core.SetExternalInterrupt(false);
   }
 
+  // The code of cached images is only freed by resetting the whole code space, which can't be done
+  // while running it. Do it here once the space for the running ucode is used up.
+  if (GetSpaceLeft() < COMPILED_CODE_SIZE / 2)
+    ClearIRAMandDSPJITCodespaceReset();
+
   m_cycles_left = cycles;
   auto exec_addr = (DSPCompiledCode)m_enter_dispatcher;
   exec_addr();
 
-  if (m_dsp_core.DSPState().reset_dspjit_codespace)
-    ClearIRAMandDSPJITCodespaceReset();
-
   return m_cycles_left;
 }
 
@@ -73,16 +80,19 @@ void DSPEmitter::DoState(PointerWrap& p)
   p.Do(m_cycles_left);
 }
 
+// This can be called from compiled code, when the DSP uploads a new ucode. The code of the running
+// block isn't freed, only the block tables change.
 void DSPEmitter::ClearIRAM()
 {
-  for (size_t i = 0; i < DSP_IRAM_SIZE; i++)
-  {
-    m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
-    m_block_links[i] = nullptr;
-    m_block_size[i] = 0;
-    m_unresolved_jumps[i].clear();
-  }
-  m_dsp_core.DSPState().reset_dspjit_codespace = true;
+  const u16* iram = m_dsp_core.DSPState().iram;
+  const u64 iram_hash = XXH64(iram, DSP_IRAM_BYTE_SIZE, 0);
+
+  CacheCurrentImage();
+  if (!RestoreCachedImage(iram, iram_hash))
+    ResetBlocks();
+
+  m_iram.assign(iram, iram + DSP_IRAM_SIZE);
+  m_iram_hash = iram_hash;
 }
 
 void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
@@ -91,14 +101,61 @@ void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
   CompileDispatcher();
   m_stub_entry_point = CompileStub();
 
-  for (size_t i = 0; i < MAX_BLOCKS; i++)
-  {
-    m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
-    m_block_links[i] = nullptr;
-    m_block_size[i] = 0;
-    m_unresolved_jumps[i].clear();
-  }
-  m_dsp_core.DSPState().reset_dspjit_codespace = false;
+  m_cached_images.clear();
+  ResetBlocks();
+}
+
+void DSPEmitter::ResetBlocks()
+{
+  std::fill(m_blocks.begin(), m_blocks.end(), (DSPCompiledCode)m_stub_entry_point);
+  std::fill(m_block_links.begin(), m_block_links.end(), nullptr);
+  std::fill(m_block_size.begin(), m_block_size.end(), 0);
+  for (std::list<u16>& jumps : m_unresolved_jumps)
+    jumps.clear();
+}
+
+void DSPEmitter::CacheCurrentImage()
+{
+  if (m_iram.empty())
+    return;
+
+  // The dispatcher refers to m_blocks directly, so its contents are copied rather than moved.
+  CachedImage image{m_iram_hash,
+                    std::move(m_iram),
+                    m_blocks,
+                    std::move(m_block_size),
+                    std::move(m_block_links),
+                    std::move(m_unresolved_jumps),
+                    m_compile_status_register};
+  m_cached_images.push_front(std::move(image));
+  if (m_cached_images.size() > MAX_CACHED_IMAGES)
+    m_cached_images.pop_back();
+
+  m_iram.clear();
+  m_block_size.assign(MAX_BLOCKS, 0);
+  m_block_links.assign(MAX_BLOCKS, nullptr);
+  m_unresolved_jumps.assign(MAX_BLOCKS, {});
+}
+
+bool DSPEmitter::RestoreCachedImage(const u16* iram, u64 iram_hash)
+{
+  const auto it =
+      std::find_if(m_cached_images.begin(), m_cached_images.end(), [&](const CachedImage& image) {
+        return image.iram_hash == iram_hash &&
+               std::equal(image.iram.begin(), image.iram.end(), iram);
+      });
+  if (it == m_cached_images.end())
+    return false;
+
+  std::copy(it->blocks.begin(), it->blocks.end(), m_blocks.begin());
+  m_block_size = std::move(it->block_size);
+  m_block_links = std::move(it->block_links);
+  m_unresolved_jumps = std::move(it->unresolved_jumps);
+  m_compile_status_register = it->compile_status_register;
+  m_cached_images.erase(it);
+
+  INFO_LOG_FMT(DSPLLE, "Restored compiled code for IRAM hash {:016x}", iram_hash);
+  return true;
 }
 
 static void CheckExceptionsThunk(DSPCore& dsp)
@@ -202,6 +202,12 @@ private:
 
   void EmitInstruction(UDSPInstruction inst);
   void ClearIRAMandDSPJITCodespaceReset();
+  void ResetBlocks();
+
+  // Moves the blocks compiled for the current IRAM contents to the image cache.
+  void CacheCurrentImage();
+  // Restores the blocks compiled for the given IRAM contents. Returns false if they aren't cached.
+  bool RestoreCachedImage(const u16* iram, u64 iram_hash);
 
   void CompileDispatcher();
   Block CompileStub();
@@ -300,6 +306,21 @@ private:
   void multiply_mulx(u8 axh0, u8 axh1);
 
   static constexpr size_t MAX_BLOCKS = 0x10000;
+  static constexpr size_t MAX_CACHED_IMAGES = 8;
+
+  // The blocks compiled for an IRAM content (a ucode), kept around while other ucodes run so that
+  // switching back to it doesn't need to recompile it. Blocks in IROM can link to blocks in IRAM,
+  // so the whole block tables are part of an image.
+  struct CachedImage
+  {
+    u64 iram_hash;
+    std::vector<u16> iram;
+    std::vector<DSPCompiledCode> blocks;
+    std::vector<u16> block_size;
+    std::vector<Block> block_links;
+    std::vector<std::list<u16>> unresolved_jumps;
+    u16 compile_status_register;
+  };
 
   DSPJitRegCache m_gpr{*this};
 
@@ -312,7 +333,13 @@ private:
   std::vector<Block> m_block_links;
   Block m_block_link_entry;
 
-  std::array<std::list<u16>, MAX_BLOCKS> m_unresolved_jumps;
+  std::vector<std::list<u16>> m_unresolved_jumps;
+
+  // The IRAM contents the current blocks were compiled for. Empty before the first ucode upload.
+  std::vector<u16> m_iram;
+  u64 m_iram_hash = 0;
+  // Most recently used first.
+  std::list<CachedImage> m_cached_images;
 
   u16 m_cycles_left = 0;
 
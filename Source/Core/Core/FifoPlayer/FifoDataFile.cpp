@@ -10,6 +10,10 @@
 #include <string>
 #include <vector>
 
+#include <xxhash.h>
+#include <zstd.h>
+
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
@@ -18,11 +22,11 @@
 enum
 {
   FILE_ID = 0x0d01f1f0,
-  VERSION_NUMBER = 5,
-  MIN_LOADER_VERSION = 1,
-  // This value is only used if the DFF file was created with overridden RAM sizes.
-  // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
-  MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5,
+  VERSION_NUMBER = 6,
+  // Version 6 compresses frames and stores memory updates separately from them.
+  MIN_LOADER_VERSION = 6,
+  // Frames are compressed while recording, so this favors speed over size.
+  COMPRESSION_LEVEL = 3,
 };
 
 #pragma pack(push, 1)
@@ -61,7 +65,10 @@ struct FileFrameInfo
   u32 fifoEnd;
   u64 memoryUpdatesOffset;
   u32 numMemoryUpdates;
-  u8 reserved[32];
+  // Version 6: size of the compressed block at fifoDataOffset, which holds the FIFO data followed
+  // by the memory update list. memoryUpdatesOffset is unused.
+  u32 compressedSize;
+  u8 reserved[28];
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
@@ -76,11 +83,55 @@ struct FileMemoryUpdate
 };
 static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 bytes");
 
+// Version 6: header of the compressed memory update data at FileMemoryUpdate::dataOffset. Updates
+// with the same data share it.
+struct FileMemoryBlob
+{
+  u32 compressedSize;
+  u8 reserved[4];
+};
+static_assert(sizeof(FileMemoryBlob) == 8, "FileMemoryBlob should be 8 bytes");
+
 #pragma pack(pop)
 
+namespace
+{
+std::vector<u8> Compress(const u8* data, size_t size)
+{
+  std::vector<u8> compressed(ZSTD_compressBound(size));
+  const size_t compressed_size =
+      ZSTD_compress(compressed.data(), compressed.size(), data, size, COMPRESSION_LEVEL);
+  compressed.resize(ZSTD_isError(compressed_size) ? 0 : compressed_size);
+  return compressed;
+}
+
+bool ReadCompressed(File::IOFile& file, u32 compressedSize, u8* data, size_t size)
+{
+  std::vector<u8> compressed(compressedSize);
+  if (!file.ReadBytes(compressed.data(), compressed.size()))
+    return false;
+
+  return ZSTD_decompress(data, size, compressed.data(), compressed.size()) == size;
+}
+
+bool ReadMemoryBlob(File::IOFile& file, u64 offset, std::vector<u8>& data)
+{
+  FileMemoryBlob blob;
+  return file.Seek(offset, SEEK_SET) && file.ReadBytes(&blob, sizeof(blob)) &&
+         ReadCompressed(file, blob.compressedSize, data.data(), data.size());
+}
+}  // Anonymous namespace
+
 FifoDataFile::FifoDataFile() = default;
 
-FifoDataFile::~FifoDataFile() = default;
+FifoDataFile::~FifoDataFile()
+{
+  if (m_File && m_DeleteOnClose)
+  {
+    m_File->Close();
+    File::Delete(m_Filename);
+  }
+}
 
 bool FifoDataFile::ShouldGenerateFakeVIUpdates() const
 {
@@ -102,23 +153,184 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
+bool FifoDataFile::StreamToFile(const std::string& filename, bool deleteOnClose)
+{
+  auto file = std::make_unique<File::IOFile>(filename, "w+b");
+  if (!*file)
+    return false;
+
+  // Add space for header
+  PadFile(sizeof(FileHeader), *file);
+
+  m_File = std::move(file);
+  m_Filename = filename;
+  m_IsWriting = true;
+  m_DeleteOnClose = deleteOnClose;
+  return true;
+}
+
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  if (m_File)
+  {
+    std::lock_guard lk(m_FileLock);
+    WriteFrame(frameInfo);
+  }
+  else
+  {
+    m_Frames.push_back(std::make_shared<FifoFrameInfo>(frameInfo));
+  }
+
+  ++m_FrameCount;
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  if (!m_File)
+    return m_Frames[frame];
+
+  std::lock_guard lk(m_FileLock);
+
+  const auto cached = std::find_if(m_FrameCache.begin(), m_FrameCache.end(),
+                                   [frame](const auto& entry) { return entry.first == frame; });
+  if (cached != m_FrameCache.end())
+    return cached->second;
+
+  std::shared_ptr<const FifoFrameInfo> frameInfo = ReadFrame(m_FrameLocations[frame]);
+  if (m_FrameCache.size() >= FRAME_CACHE_SIZE)
+    m_FrameCache.erase(m_FrameCache.begin());
+  m_FrameCache.emplace_back(frame, frameInfo);
+  return frameInfo;
 }
 
 bool FifoDataFile::Save(const std::string& filename)
 {
-  File::IOFile file;
-  if (!file.Open(filename, "wb"))
+  // The file is written next to the destination and then renamed over it, so that the destination
+  // stays intact if writing fails, and so that a loaded file can be saved over itself.
+  const std::string temp_filename = File::GetTempFilenameForAtomicWrite(filename);
+
+  if (m_IsWriting)
+  {
+    std::lock_guard lk(m_FileLock);
+    if (!m_IsComplete && !WriteTrailer())
+      return false;
+
+    m_IsComplete = true;
+    if (filename == m_Filename)
+      return true;
+
+    if (!File::Copy(m_Filename, temp_filename) || !File::Rename(temp_filename, filename))
+    {
+      File::Delete(temp_filename, File::IfAbsentBehavior::NoConsoleWarning);
+      return false;
+    }
+    return true;
+  }
+
+  // Deletes the temporary file unless it has been renamed.
+  auto file = std::make_unique<FifoDataFile>();
+  if (!file->StreamToFile(temp_filename, true))
     return false;
 
-  // Add space for header
-  PadFile(sizeof(FileHeader), file);
+  file->m_Flags = m_Flags;
+  std::copy_n(m_BPMem, BP_MEM_SIZE, file->m_BPMem);
+  std::copy_n(m_CPMem, CP_MEM_SIZE, file->m_CPMem);
+  std::copy_n(m_XFMem, XF_MEM_SIZE, file->m_XFMem);
+  std::copy_n(m_XFRegs, XF_REGS_SIZE, file->m_XFRegs);
+  std::copy_n(m_TexMem, TEX_MEM_SIZE, file->m_TexMem);
+  for (u32 i = 0; i < m_FrameCount; ++i)
+    file->AddFrame(*GetFrame(i));
 
-  // Add space for frame list
-  u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  if (!file->WriteTrailer())
+    return false;
+  file->m_File->Close();
+
+  std::lock_guard lk(m_FileLock);
+
+  // Frames of version 6 files are read from the file on demand. Windows can't rename over a file
+  // which is open, so it is closed and then reopened to read the frames from the new file.
+  const bool replaces_own_file = m_File && filename == m_Filename;
+  if (replaces_own_file)
+    m_File->Close();
+
+  if (!File::Rename(temp_filename, filename))
+  {
+    if (replaces_own_file)
+      m_File->Open(m_Filename, "rb");
+    return false;
+  }
+  file->m_DeleteOnClose = false;
+
+  if (replaces_own_file)
+  {
+    m_File->Open(m_Filename, "rb");
+    m_FrameLocations = std::move(file->m_FrameLocations);
+    m_FrameCache.clear();
+  }
+
+  return true;
+}
+
+void FifoDataFile::WriteFrame(const FifoFrameInfo& frameInfo)
+{
+  // The FIFO data and the memory update list are compressed together, while the data of each
+  // memory update is stored in a shared blob.
+  const size_t fifoDataSize = frameInfo.fifoData.size();
+  std::vector<u8> block(fifoDataSize + frameInfo.memoryUpdates.size() * sizeof(FileMemoryUpdate));
+  std::copy(frameInfo.fifoData.begin(), frameInfo.fifoData.end(), block.begin());
+
+  for (size_t i = 0; i < frameInfo.memoryUpdates.size(); ++i)
+  {
+    const MemoryUpdate& srcUpdate = frameInfo.memoryUpdates[i];
+
+    FileMemoryUpdate dstUpdate{};
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.dataOffset = WriteMemoryBlob(srcUpdate.data);
+    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.type = srcUpdate.type;
+    std::memcpy(&block[fifoDataSize + i * sizeof(FileMemoryUpdate)], &dstUpdate,
+                sizeof(FileMemoryUpdate));
+  }
+
+  const std::vector<u8> compressed = Compress(block.data(), block.size());
+
+  m_File->Seek(0, SEEK_END);
+  FrameLocation& location = m_FrameLocations.emplace_back();
+  location.offset = m_File->Tell();
+  location.compressedSize = static_cast<u32>(compressed.size());
+  location.fifoDataSize = static_cast<u32>(fifoDataSize);
+  location.fifoStart = frameInfo.fifoStart;
+  location.fifoEnd = frameInfo.fifoEnd;
+  location.numMemoryUpdates = static_cast<u32>(frameInfo.memoryUpdates.size());
+  m_File->WriteBytes(compressed.data(), compressed.size());
+}
+
+u64 FifoDataFile::WriteMemoryBlob(const std::vector<u8>& data)
+{
+  const BlobKey key{XXH64(data.data(), data.size(), 0), XXH64(data.data(), data.size(), 1),
+                    static_cast<u32>(data.size())};
+  const auto existing = m_Blobs.find(key);
+  if (existing != m_Blobs.end())
+    return existing->second;
+
+  const std::vector<u8> compressed = Compress(data.data(), data.size());
+  FileMemoryBlob blob{};
+  blob.compressedSize = static_cast<u32>(compressed.size());
+
+  m_File->Seek(0, SEEK_END);
+  const u64 offset = m_File->Tell();
+  m_File->WriteBytes(&blob, sizeof(FileMemoryBlob));
+  m_File->WriteBytes(compressed.data(), compressed.size());
+
+  m_Blobs.emplace(key, offset);
+  return offset;
+}
+
+bool FifoDataFile::WriteTrailer()
+{
+  File::IOFile& file = *m_File;
+  file.Seek(0, SEEK_END);
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem, BP_MEM_SIZE);
@@ -135,15 +347,25 @@ bool FifoDataFile::Save(const std::string& filename)
   u64 texMemOffset = file.Tell();
   file.WriteArray(m_TexMem, TEX_MEM_SIZE);
 
+  // Write frames list
+  u64 frameListOffset = file.Tell();
+  for (const FrameLocation& location : m_FrameLocations)
+  {
+    FileFrameInfo dstFrame{};
+    dstFrame.fifoDataOffset = location.offset;
+    dstFrame.fifoDataSize = location.fifoDataSize;
+    dstFrame.fifoStart = location.fifoStart;
+    dstFrame.fifoEnd = location.fifoEnd;
+    dstFrame.numMemoryUpdates = location.numMemoryUpdates;
+    dstFrame.compressedSize = location.compressedSize;
+    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+  }
+
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
-    header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
-  else
-    header.min_loader_version = MIN_LOADER_VERSION;
+  header.min_loader_version = MIN_LOADER_VERSION;
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -161,7 +383,7 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = static_cast<u32>(m_FrameLocations.size());
 
   header.flags = m_Flags;
 
@@ -171,36 +393,47 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, SEEK_SET);
   file.WriteBytes(&header, sizeof(FileHeader));
 
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
-  {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
+  return file.Flush();
+}
 
-    // Write FIFO data
-    file.Seek(0, SEEK_END);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
+std::shared_ptr<const FifoFrameInfo>
+FifoDataFile::ReadFrame(const FrameLocation& location) const
+{
+  auto frame = std::make_shared<FifoFrameInfo>();
+  frame->fifoStart = location.fifoStart;
+  frame->fifoEnd = location.fifoEnd;
+
+  std::vector<u8> block(location.fifoDataSize +
+                        location.numMemoryUpdates * sizeof(FileMemoryUpdate));
+  if (!m_File->Seek(location.offset, SEEK_SET) ||
+      !ReadCompressed(*m_File, location.compressedSize, block.data(), block.size()))
+  {
+    PanicAlertFmt("FifoDataFile: Failed to read the frame at offset {}", location.offset);
+    return frame;
+  }
 
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+  frame->fifoData.assign(block.begin(), block.begin() + location.fifoDataSize);
+  frame->memoryUpdates.resize(location.numMemoryUpdates);
+  for (u32 i = 0; i < location.numMemoryUpdates; ++i)
+  {
+    FileMemoryUpdate srcUpdate;
+    std::memcpy(&srcUpdate, &block[location.fifoDataSize + i * sizeof(FileMemoryUpdate)],
+                sizeof(FileMemoryUpdate));
 
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
+    MemoryUpdate& dstUpdate = frame->memoryUpdates[i];
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.data.resize(srcUpdate.dataSize);
+    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
 
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, SEEK_SET);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+    if (!ReadMemoryBlob(*m_File, srcUpdate.dataOffset, dstUpdate.data))
+    {
+      PanicAlertFmt("FifoDataFile: Failed to read the memory update at offset {}",
+                    srcUpdate.dataOffset);
+    }
   }
 
-  if (!file.Close())
-    return false;
-
-  return true;
+  return frame;
 }
 
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
@@ -305,6 +538,20 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     FileFrameInfo srcFrame;
     file.ReadBytes(&srcFrame, sizeof(FileFrameInfo));
 
+    // Compressed frames are read when they are used.
+    if (dataFile->m_Version >= 6)
+    {
+      FrameLocation& location = dataFile->m_FrameLocations.emplace_back();
+      location.offset = srcFrame.fifoDataOffset;
+      location.compressedSize = srcFrame.compressedSize;
+      location.fifoDataSize = srcFrame.fifoDataSize;
+      location.fifoStart = srcFrame.fifoStart;
+      location.fifoEnd = srcFrame.fifoEnd;
+      location.numMemoryUpdates = srcFrame.numMemoryUpdates;
+      ++dataFile->m_FrameCount;
+      continue;
+    }
+
     FifoFrameInfo dstFrame;
     dstFrame.fifoData.resize(srcFrame.fifoDataSize);
     dstFrame.fifoStart = srcFrame.fifoStart;
@@ -319,6 +566,13 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     dataFile->AddFrame(dstFrame);
   }
 
+  if (dataFile->m_Version >= 6)
+  {
+    dataFile->m_File = std::make_unique<File::IOFile>(std::move(file));
+    dataFile->m_Filename = filename;
+    return dataFile;
+  }
+
   file.Close();
 
   return dataFile;
@@ -343,37 +597,6 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
-{
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
-
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
-  {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
-
-    // Write memory
-    file.Seek(0, SEEK_END);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
-
-    FileMemoryUpdate dstUpdate;
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.type = srcUpdate.type;
-
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, SEEK_SET);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
-  }
-
-  return updateListOffset;
-}
-
 void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                      std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
 {
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -72,9 +75,15 @@ public:
   u32 GetRamSizeReal() { return m_ram_size_real; }
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
+  // Writes frames to the file as they are added instead of keeping them in memory. Save()
+  // completes the file and copies it to the destination.
+  bool StreamToFile(const std::string& filename, bool deleteOnClose);
+
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // Frames of version 6 files are read and decompressed on demand, so only a few of them are kept
+  // in memory. The returned frame stays valid while other frames are loaded.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const { return m_FrameCount; }
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -85,12 +94,32 @@ private:
     FLAG_IS_WII = 1
   };
 
+  // Location of a compressed frame in a version 6 file.
+  struct FrameLocation
+  {
+    u64 offset;
+    u32 compressedSize;
+    u32 fifoDataSize;
+    u32 fifoStart;
+    u32 fifoEnd;
+    u32 numMemoryUpdates;
+  };
+
+  // Memory updates with the same contents are only stored once. They are looked up by two hashes
+  // with different seeds and the size of the data.
+  using BlobKey = std::tuple<u64, u64, u32>;
+
+  static constexpr size_t FRAME_CACHE_SIZE = 4;
+
   void PadFile(size_t numBytes, File::IOFile& file);
 
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  void WriteFrame(const FifoFrameInfo& frameInfo);
+  u64 WriteMemoryBlob(const std::vector<u8>& data);
+  bool WriteTrailer();
+  std::shared_ptr<const FifoFrameInfo> ReadFrame(const FrameLocation& location) const;
   static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                 std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
 
@@ -105,5 +134,20 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  u32 m_FrameCount = 0;
+  // Frames of files older than version 6, and of files which are not streamed to disk.
+  std::vector<std::shared_ptr<const FifoFrameInfo>> m_Frames;
+
+  // The file which frames are streamed from or to.
+  std::unique_ptr<File::IOFile> m_File;
+  std::string m_Filename;
+  bool m_IsWriting = false;
+  bool m_IsComplete = false;
+  bool m_DeleteOnClose = false;
+  std::vector<FrameLocation> m_FrameLocations;
+  std::map<BlobKey, u64> m_Blobs;
+
+  // Guards the file and the cache, as frames are read from both the CPU and the GUI threads.
+  mutable std::mutex m_FileLock;
+  mutable std::vector<std::pair<u32, std::shared_ptr<const FifoFrameInfo>>> m_FrameCache;
 };
@@ -7,8 +7,11 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Swap.h"
 #include "Core/FifoPlayer/FifoAnalyzer.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/OpcodeDecoding.h"
 
 using namespace FifoAnalyzer;
 
@@ -40,7 +43,8 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
 
   for (u32 frameIdx = 0; frameIdx < file->GetFrameCount(); ++frameIdx)
   {
-    const FifoFrameInfo& frame = file->GetFrame(frameIdx);
+    const auto frame_ptr = file->GetFrame(frameIdx);
+    const FifoFrameInfo& frame = *frame_ptr;
     AnalyzedFrameInfo& analyzed = frameInfo[frameIdx];
 
     s_DrawingObject = false;
@@ -100,3 +104,69 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
       analyzed.objectEnds.push_back(cmdStart);
   }
 }
+
+void FifoPlaybackAnalyzer::ApplyRegisterLoads(const FifoFrameInfo& frame, FifoRegisterState& state)
+{
+  // The command sizes of primitives depend on the vertex format at the start of the frame.
+  const u32* cpMem = state.cpMem.data();
+  FifoAnalyzer::LoadCPReg(0x50, cpMem[0x50], s_CpMem);
+  FifoAnalyzer::LoadCPReg(0x60, cpMem[0x60], s_CpMem);
+  for (int i = 0; i < 8; ++i)
+  {
+    FifoAnalyzer::LoadCPReg(0x70 + i, cpMem[0x70 + i], s_CpMem);
+    FifoAnalyzer::LoadCPReg(0x80 + i, cpMem[0x80 + i], s_CpMem);
+    FifoAnalyzer::LoadCPReg(0x90 + i, cpMem[0x90 + i], s_CpMem);
+  }
+
+  u32 cmdStart = 0;
+  while (cmdStart < frame.fifoData.size())
+  {
+    const u8* data = &frame.fifoData[cmdStart];
+
+    switch (data[0])
+    {
+    case OpcodeDecoder::GX_LOAD_BP_REG:
+    {
+      const u32 cmd = Common::swap32(data + 1);
+      const u32 reg = cmd >> 24;
+      const u32 value = cmd & 0xFFFFFF;
+
+      // Same masking as LoadBPReg.
+      const u32 mask = state.bpMem[BPMEM_BP_MASK];
+      state.bpMem[reg] = (state.bpMem[reg] & ~mask) | (value & mask);
+      if (reg != BPMEM_BP_MASK)
+        state.bpMem[BPMEM_BP_MASK] = 0xFFFFFF;
+      break;
+    }
+
+    case OpcodeDecoder::GX_LOAD_CP_REG:
+      state.cpMem[data[1]] = Common::swap32(data + 2);
+      break;
+
+    case OpcodeDecoder::GX_LOAD_XF_REG:
+    {
+      const u32 cmd = Common::swap32(data + 1);
+      const u32 address = cmd & 0xFFFF;
+      const u32 size = ((cmd >> 16) & 15) + 1;
+      for (u32 i = 0; i < size; ++i)
+      {
+        const u32 value = Common::swap32(data + 5 + i * sizeof(u32));
+        if (address + i < FifoDataFile::XF_MEM_SIZE)
+          state.xfMem[address + i] = value;
+        else if (address + i - 0x1000 < FifoDataFile::XF_REGS_SIZE)
+          state.xfRegs[address + i - 0x1000] = value;
+      }
+      break;
+    }
+
+    default:
+      break;
+    }
+
+    const u32 cmdSize = FifoAnalyzer::AnalyzeCommand(data, DecodeMode::Playback);
+    if (cmdSize == 0)
+      return;
+
+    cmdStart += cmdSize;
+  }
+}
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <vector>
 
@@ -16,7 +17,20 @@ struct AnalyzedFrameInfo
   std::vector<MemoryUpdate> memoryUpdates;
 };
 
+// BP, CP and XF register state, laid out like the initial state in FifoDataFile.
+struct FifoRegisterState
+{
+  std::array<u32, FifoDataFile::BP_MEM_SIZE> bpMem;
+  std::array<u32, FifoDataFile::CP_MEM_SIZE> cpMem;
+  std::array<u32, FifoDataFile::XF_MEM_SIZE> xfMem;
+  std::array<u32, FifoDataFile::XF_REGS_SIZE> xfRegs;
+};
+
 namespace FifoPlaybackAnalyzer
 {
 void AnalyzeFrames(FifoDataFile* file, std::vector<AnalyzedFrameInfo>& frameInfo);
+
+// Applies the BP, CP and XF register loads of the frame to the state, without drawing anything.
+// Indexed XF loads are not applied, as they read from memory at the time they are executed.
+void ApplyRegisterLoads(const FifoFrameInfo& frame, FifoRegisterState& state);
 }  // namespace FifoPlaybackAnalyzer
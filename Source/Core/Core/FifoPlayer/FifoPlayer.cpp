@@ -52,6 +52,13 @@ bool FifoPlayer::Open(const std::string& filename)
     FifoPlaybackAnalyzer::AnalyzeFrames(m_File.get(), m_FrameInfo);
 
     m_FrameRangeEnd = m_File->GetFrameCount();
+
+    m_Keyframes.clear();
+    FifoRegisterState& registers = m_Keyframes.emplace_back().registers;
+    std::copy_n(m_File->GetBPMem(), registers.bpMem.size(), registers.bpMem.begin());
+    std::copy_n(m_File->GetCPMem(), registers.cpMem.size(), registers.cpMem.begin());
+    std::copy_n(m_File->GetXFMem(), registers.xfMem.size(), registers.xfMem.begin());
+    std::copy_n(m_File->GetXFRegs(), registers.xfRegs.size(), registers.xfRegs.begin());
   }
 
   if (m_FileLoadedCb)
@@ -63,6 +70,7 @@ bool FifoPlayer::Open(const std::string& filename)
 void FifoPlayer::Close()
 {
   m_File.reset();
+  m_Keyframes.clear();
 
   m_FrameRangeStart = 0;
   m_FrameRangeEnd = 0;
@@ -86,6 +94,8 @@ public:
     IsPlayingBackFifologWithBrokenEFBCopies = m_parent->m_File->HasBrokenEFBCopies();
 
     m_parent->m_CurrentFrame = m_parent->m_FrameRangeStart;
+    m_parent->m_NextFrame = 0;
+    m_parent->m_PlaybacksDone = 0;
     m_parent->LoadMemory();
   }
 
@@ -133,33 +143,86 @@ CPU::State FifoPlayer::AdvanceFrame()
 {
   if (m_CurrentFrame >= m_FrameRangeEnd)
   {
-    if (!m_Loop)
+    ++m_PlaybacksDone;
+    if (m_PlaybackCount != 0 ? m_PlaybacksDone >= m_PlaybackCount : !m_Loop)
       return CPU::State::PowerDown;
     // If there are zero frames in the range then sleep instead of busy spinning
     if (m_FrameRangeStart >= m_FrameRangeEnd)
       return CPU::State::Stepping;
 
-    // When looping, reload the contents of all the BP/CP/CF registers.
+    // When looping, the seek below reloads the state at the start of the range.
     // This ensures that each time the first frame is played back, the state of the
     // GPU is the same for each playback loop.
     m_CurrentFrame = m_FrameRangeStart;
-    LoadRegisters();
-    LoadTextureMemory();
-    FlushWGP();
   }
 
+  // Frames were skipped or repeated, by looping or by changing the frame range.
+  if (m_CurrentFrame != m_NextFrame)
+    SeekToFrame(m_CurrentFrame);
+
   if (m_FrameWrittenCb)
     m_FrameWrittenCb();
 
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  WriteFrame(*m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
 
   ++m_CurrentFrame;
+  m_NextFrame = m_CurrentFrame;
   return CPU::State::Running;
 }
 
+void FifoPlayer::SeekToFrame(u32 frame)
+{
+  const u32 keyframe_index = frame / KEYFRAME_INTERVAL;
+  Keyframe state = GetKeyframe(keyframe_index);
+  AdvanceKeyframe(state, keyframe_index * KEYFRAME_INTERVAL, frame);
+
+  // Write the updates in the order in which they were recorded, as ranges may overlap.
+  std::vector<std::pair<u32, u32>> updates;
+  for (const auto& entry : state.memoryUpdates)
+    updates.push_back(entry.second);
+  std::sort(updates.begin(), updates.end());
+
+  for (const auto& [frame_index, update_index] : updates)
+    WriteMemory(m_File->GetFrame(frame_index)->memoryUpdates[update_index]);
+
+  LoadRegisters(state.registers);
+  LoadTextureMemory();
+  FlushWGP();
+}
+
+const FifoPlayer::Keyframe& FifoPlayer::GetKeyframe(u32 index)
+{
+  while (m_Keyframes.size() <= index)
+  {
+    Keyframe next = m_Keyframes.back();
+    const u32 start = static_cast<u32>(m_Keyframes.size() - 1) * KEYFRAME_INTERVAL;
+    AdvanceKeyframe(next, start, start + KEYFRAME_INTERVAL);
+    m_Keyframes.push_back(std::move(next));
+  }
+
+  return m_Keyframes[index];
+}
+
+void FifoPlayer::AdvanceKeyframe(Keyframe& keyframe, u32 start, u32 end) const
+{
+  for (u32 frame_index = start; frame_index < end; ++frame_index)
+  {
+    const auto frame = m_File->GetFrame(frame_index);
+    FifoPlaybackAnalyzer::ApplyRegisterLoads(*frame, keyframe.registers);
+
+    // Only the last update to each range is needed, as earlier ones are completely overwritten.
+    for (u32 update_index = 0; update_index < frame->memoryUpdates.size(); ++update_index)
+    {
+      const MemoryUpdate& update = frame->memoryUpdates[update_index];
+      keyframe.memoryUpdates[{update.address, static_cast<u32>(update.data.size())}] = {
+          frame_index, update_index};
+    }
+  }
+}
+
 std::unique_ptr<CPUCoreBase> FifoPlayer::GetCPUCore()
 {
   if (!m_File || m_File->GetFrameCount() == 0)
@@ -345,8 +408,8 @@ void FifoPlayer::WriteAllMemoryUpdates()
 
   for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
   {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
-    for (auto& update : frame.memoryUpdates)
+    const auto frame = m_File->GetFrame(frameNum);
+    for (auto& update : frame->memoryUpdates)
     {
       WriteMemory(update);
     }
@@ -401,7 +464,8 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const auto frame_ptr = m_File->GetFrame(m_CurrentFrame);
+  const FifoFrameInfo& frame = *frame_ptr;
 
   // Set fifo bounds
   WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
@@ -452,21 +516,21 @@ void FifoPlayer::LoadMemory()
   PowerPC::IBATUpdated();
 
   SetupFifo();
-  LoadRegisters();
+  LoadRegisters(m_Keyframes[0].registers);
   LoadTextureMemory();
   FlushWGP();
 }
 
-void FifoPlayer::LoadRegisters()
+void FifoPlayer::LoadRegisters(const FifoRegisterState& registers)
 {
-  const u32* regs = m_File->GetBPMem();
+  const u32* regs = registers.bpMem.data();
   for (int i = 0; i < FifoDataFile::BP_MEM_SIZE; ++i)
   {
     if (ShouldLoadBP(i))
       LoadBPReg(i, regs[i]);
   }
 
-  regs = m_File->GetCPMem();
+  regs = registers.cpMem.data();
   LoadCPReg(0x30, regs[0x30]);
   LoadCPReg(0x40, regs[0x40]);
   LoadCPReg(0x50, regs[0x50]);
@@ -485,11 +549,11 @@ void FifoPlayer::LoadRegisters()
     LoadCPReg(0xb0 + i, regs[0xb0 + i]);
   }
 
-  regs = m_File->GetXFMem();
+  regs = registers.xfMem.data();
   for (int i = 0; i < FifoDataFile::XF_MEM_SIZE; i += 16)
     LoadXFMem16(i, &regs[i]);
 
-  regs = m_File->GetXFRegs();
+  regs = registers.xfRegs.data();
   for (int i = 0; i < FifoDataFile::XF_REGS_SIZE; ++i)
     LoadXFReg(i, regs[i]);
 }
@@ -5,8 +5,10 @@
 #pragma once
 
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Core/FifoPlayer/FifoDataFile.h"
@@ -92,6 +94,9 @@ public:
   // If enabled then all memory updates happen at once before the first frame
   // Default is disabled
   void SetEarlyMemoryUpdates(bool enabled) { m_EarlyMemoryUpdates = enabled; }
+  // Number of times the frame range is played before stopping. If 0, playback loops according to
+  // the loop setting.
+  void SetPlaybackCount(u32 count) { m_PlaybackCount = count; }
   // Callbacks
   void SetFileLoadedCallback(CallbackFunc callback);
   void SetFrameWrittenCallback(CallbackFunc callback) { m_FrameWrittenCb = std::move(callback); }
@@ -102,10 +107,30 @@ public:
 private:
   class CPUCore;
 
+  // Register state and memory updates needed to start playback at a frame, without playing the
+  // frames before it.
+  struct Keyframe
+  {
+    FifoRegisterState registers;
+    // Frame and index of the last update to each memory range (address and size) before the
+    // keyframe.
+    std::map<std::pair<u32, u32>, std::pair<u32, u32>> memoryUpdates;
+  };
+  static constexpr u32 KEYFRAME_INTERVAL = 100;
+
   FifoPlayer();
 
   CPU::State AdvanceFrame();
 
+  // Loads the register and memory state at the start of the frame, without drawing the frames
+  // before it. EFB contents, TMEM preloads and indexed XF loads of skipped frames are not
+  // reproduced; games normally set those up again within a few frames.
+  void SeekToFrame(u32 frame);
+  // Returns the keyframe at frame index * KEYFRAME_INTERVAL, creating the keyframes up to it.
+  const Keyframe& GetKeyframe(u32 index);
+  // Applies the register loads and memory updates of frames [start, end) to the keyframe.
+  void AdvanceKeyframe(Keyframe& keyframe, u32 start, u32 end) const;
+
   void WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo& info);
   void WriteFramePart(u32 dataStart, u32 dataEnd, u32& nextMemUpdate, const FifoFrameInfo& frame,
                       const AnalyzedFrameInfo& info);
@@ -120,7 +145,7 @@ private:
   void SetupFifo();
 
   void LoadMemory();
-  void LoadRegisters();
+  void LoadRegisters(const FifoRegisterState& registers);
   void LoadTextureMemory();
 
   void WriteCP(u32 address, u16 value);
@@ -139,8 +164,12 @@ private:
   static bool IsHighWatermarkSet();
 
   bool m_Loop;
+  u32 m_PlaybackCount = 0;
+  u32 m_PlaybacksDone = 0;
 
   u32 m_CurrentFrame = 0;
+  // Frame following the last frame written. Playback seeks when the current frame differs.
+  u32 m_NextFrame = 0;
   u32 m_FrameRangeStart = 0;
   u32 m_FrameRangeEnd = 0;
 
@@ -159,4 +188,6 @@ private:
   std::unique_ptr<FifoDataFile> m_File;
 
   std::vector<AnalyzedFrameInfo> m_FrameInfo;
+  // One keyframe every KEYFRAME_INTERVAL frames, created as far as playback has seeked.
+  std::vector<Keyframe> m_Keyframes;
 };
@@ -7,7 +7,12 @@
 #include <algorithm>
 #include <cstring>
 
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Random.h"
 #include "Common/Thread.h"
 #include "Core/ConfigManager.h"
 #include "Core/FifoPlayer/FifoAnalyzer.h"
@@ -24,6 +29,15 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 
   m_File = std::make_unique<FifoDataFile>();
 
+  // Write frames to disk as they are recorded, so that long recordings don't need to fit in RAM.
+  // If the scratch file can't be created, the recording is kept in memory instead. The name is
+  // random so that several instances sharing a user directory don't write to the same file.
+  const std::string scratch_path =
+      fmt::format("{}FifoRecording-{:016x}.dff", File::GetUserPath(D_CACHE_IDX),
+                  Common::Random::GenerateValue<u64>());
+  if (!m_File->StreamToFile(scratch_path, true))
+    WARN_LOG_FMT(VIDEO, "FifoRecorder: Failed to create {}", scratch_path);
+
   // TODO: This, ideally, would be deallocated when done recording.
   //       However, care needs to be taken since global state
   //       and multithreading don't play well nicely together.
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <array>
 #include <iterator>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -14,10 +15,12 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceWorkers.h"
 
 #define AX_GC
 #include "Core/HW/DSPHLE/UCodes/AXVoice.h"
@@ -27,6 +30,10 @@ namespace DSP::HLE
 AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc), m_cmdlist_size(0)
 {
   INFO_LOG_FMT(DSPHLE, "Instantiating AXUCode: crc={:08x}", crc);
+
+  const int voice_threads = Config::Get(Config::MAIN_DSP_HLE_VOICE_THREADS);
+  if (voice_threads > 1)
+    m_voice_workers = std::make_unique<AXVoiceWorkers>(static_cast<u32>(voice_threads));
 }
 
 AXUCode::~AXUCode()
@@ -415,15 +422,14 @@ void AXUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPB pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_left, m_samples_right, m_samples_surround, m_samples_auxA_left,
-                          m_samples_auxA_right, m_samples_auxA_surround, m_samples_auxB_left,
-                          m_samples_auxB_right, m_samples_auxB_surround}};
+  const AXBuffers buffers = {{m_samples_left, m_samples_right, m_samples_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
 
-    ReadPB(pb_addr, pb, m_crc);
+  // Processes a PB, mixing it to the given buffers. Returns the address of the next PB.
+  const auto process_pb = [this](u32 addr, AXBuffers voice_buffers) {
+    AXPB pb;
+    ReadPB(addr, pb, m_crc);
 
     u32 updates_addr = HILO_TO_32(pb.updates.data);
     u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
@@ -432,17 +438,72 @@ void AXUCode::ProcessPBList(u32 pb_addr)
     {
       ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
 
-      ProcessVoice(pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
+      ProcessVoice(pb, voice_buffers, spms, ConvertMixerControl(pb.mixer_control),
                    m_coeffs_available ? m_coeffs : nullptr);
 
       // Forward the buffers
-      for (auto& ptr : buffers.ptrs)
+      for (auto& ptr : voice_buffers.ptrs)
         ptr += spms;
     }
 
-    WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
+    WritePB(addr, pb, m_crc);
+    return HILO_TO_32(pb.next_pb);
+  };
+
+  // Lists the PBs to process them in parallel. Returns false if the list can't be known before
+  // processing them.
+  const auto list_pbs = [this](u32 addr, std::vector<u32>* pb_addrs) {
+    while (addr)
+    {
+      if (pb_addrs->size() == AXVoiceWorkers::MAX_VOICES)
+        return false;
+
+      AXPB pb;
+      ReadPB(addr, pb, m_crc);
+
+      u32 num_updates = 0;
+      for (u16 count : pb.updates.num_updates)
+        num_updates += count;
+      const u16* updates = (u16*)HLEMemory_Get_Pointer(HILO_TO_32(pb.updates.data));
+      if (num_updates != 0 && UpdatesNextPB(updates, num_updates))
+        return false;
+
+      pb_addrs->push_back(addr);
+      addr = HILO_TO_32(pb.next_pb);
+    }
+    return true;
+  };
+
+  std::vector<u32> pb_addrs;
+  if (m_voice_workers && list_pbs(pb_addr, &pb_addrs))
+  {
+    std::vector<AXVoiceWorkers::MixBuffer> mix_buffers;
+    for (int* ptr : buffers.ptrs)
+      mix_buffers.push_back({ptr, spms * 5});
+
+    m_voice_workers->ProcessVoices(static_cast<u32>(pb_addrs.size()), mix_buffers,
+                                   [&](u32 voice, int* const* worker_buffers) {
+                                     AXBuffers voice_buffers;
+                                     std::copy_n(worker_buffers, std::size(voice_buffers.ptrs),
+                                                 voice_buffers.ptrs);
+                                     process_pb(pb_addrs[voice], voice_buffers);
+                                   });
+    return;
+  }
+
+  while (pb_addr)
+    pb_addr = process_pb(pb_addr, buffers);
+}
+
+bool AXUCode::UpdatesNextPB(const u16* updates, u32 num_updates)
+{
+  for (u32 i = 0; i < num_updates; ++i)
+  {
+    const u16 update_off = Common::swap16(updates[2 * i]);
+    if (update_off == 0 || update_off == 1)
+      return true;
   }
+  return false;
 }
 
 void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
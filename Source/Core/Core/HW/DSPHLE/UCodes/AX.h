@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Swap.h"
@@ -19,6 +21,7 @@
 
 namespace DSP::HLE
 {
+class AXVoiceWorkers;
 class DSPHLE;
 
 // We can't directly use the mixer_control field from the PB because it does
@@ -99,6 +102,10 @@ protected:
   bool m_coeffs_available;
   s16 m_coeffs[0x800];
 
+  // Threads processing the voices of a PB list in parallel. Null if they are processed on the
+  // CPU thread only.
+  std::unique_ptr<AXVoiceWorkers> m_voice_workers;
+
   void LoadResamplingCoefficients();
 
   // Copy a command list from memory to our temp buffer
@@ -130,6 +137,10 @@ protected:
     Common::BitCastFromArray<u16>(pb_mem, pb);
   }
 
+  // Returns whether one of the updates writes to the next_pb field of a PB. The PB list can only be
+  // known before processing the voices, which is required to process them in parallel, if none do.
+  static bool UpdatesNextPB(const u16* updates, u32 num_updates);
+
   virtual void HandleCommandList();
   void SignalWorkEnd();
 
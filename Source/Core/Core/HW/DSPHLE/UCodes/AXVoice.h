@@ -13,9 +13,15 @@
 #endif
 
 #include <algorithm>
-#include <functional>
+#include <array>
 #include <memory>
 
+#ifdef _M_X86
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #include "Common/CommonTypes.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/HW/DSP.h"
@@ -35,6 +41,9 @@ namespace DSP::HLE
 
 // Put all of that in an anonymous namespace to avoid stupid compilers merging
 // functions from AX GC and AX Wii.
+//
+// The unit tests include this header for the mixing kernels alone, so the
+// functions which only the ucodes call are marked [[maybe_unused]].
 namespace
 {
 // Useful macro to convert xxx_hi + xxx_lo to xxx for 32 bits.
@@ -93,7 +102,7 @@ bool HasLpf(u32 crc)
 }
 
 // Read a PB from MRAM/ARAM
-void ReadPB(u32 addr, PB_TYPE& pb, u32 crc)
+[[maybe_unused]] void ReadPB(u32 addr, PB_TYPE& pb, u32 crc)
 {
   if (HasLpf(crc))
   {
@@ -117,7 +126,7 @@ void ReadPB(u32 addr, PB_TYPE& pb, u32 crc)
 }
 
 // Write a PB back to MRAM/ARAM
-void WritePB(u32 addr, const PB_TYPE& pb, u32 crc)
+[[maybe_unused]] void WritePB(u32 addr, const PB_TYPE& pb, u32 crc)
 {
   if (HasLpf(crc))
   {
@@ -139,9 +148,10 @@ void WritePB(u32 addr, const PB_TYPE& pb, u32 crc)
   }
 }
 
-// Simulated accelerator state.
-static PB_TYPE* acc_pb;
-static bool acc_end_reached;
+// Simulated accelerator state. Voices can be processed on several threads at
+// once, so each one has its own.
+static thread_local PB_TYPE* acc_pb;
+static thread_local bool acc_end_reached;
 
 class HLEAccelerator final : public Accelerator
 {
@@ -188,7 +198,8 @@ protected:
   void WriteMemory(u32 address, u8 value) override { WriteARAM(value, address); }
 };
 
-static std::unique_ptr<Accelerator> s_accelerator = std::make_unique<HLEAccelerator>();
+static thread_local std::unique_ptr<Accelerator> s_accelerator =
+    std::make_unique<HLEAccelerator>();
 
 // Sets up the simulated accelerator.
 void AcceleratorSetup(PB_TYPE* pb)
@@ -204,18 +215,50 @@ void AcceleratorSetup(PB_TYPE* pb)
   acc_end_reached = false;
 }
 
-// Reads a sample from the accelerator. Also handles looping and
+// Reads <count> samples from the accelerator. Also handles looping and
 // disabling streams that reached the end (this is done by an exception raised
 // by the accelerator on real hardware).
-u16 AcceleratorGetSample()
+void AcceleratorGetSamples(s16* samples, u32 count)
 {
-  // See below for explanations about acc_end_reached.
+  // See above for explanations about acc_end_reached. Once it is set in the
+  // middle of a block, reads are stopped and the accelerator returns 0 too.
   if (acc_end_reached)
-    return 0;
+  {
+    std::fill_n(samples, count, 0);
+    return;
+  }
 
-  return s_accelerator->Read(acc_pb->adpcm.coefs);
+  s_accelerator->ReadSamples(acc_pb->adpcm.coefs, samples, count);
 }
 
+// Input callback for ResampleAudio which decodes samples from the accelerator
+// ahead of the resampler, in blocks, so that ADPCM frames are decoded at once.
+// It never reads more than <count> samples, as reads have side effects
+// (looping, stopping the voice).
+class AcceleratorBlockReader
+{
+public:
+  explicit AcceleratorBlockReader(u32 count) : m_remaining(count) {}
+
+  s16 operator()(u32)
+  {
+    if (m_position == m_size)
+    {
+      m_size = std::min<u32>(m_remaining, static_cast<u32>(m_block.size()));
+      m_remaining -= m_size;
+      m_position = 0;
+      AcceleratorGetSamples(m_block.data(), m_size);
+    }
+    return m_block[m_position++];
+  }
+
+private:
+  std::array<s16, 128> m_block;
+  u32 m_position = 0;
+  u32 m_size = 0;
+  u32 m_remaining;
+};
+
 // Reads samples from the input callback, resamples them to <count> samples at
 // the wanted sample rate (computed from the ratio, see below).
 //
@@ -236,7 +279,8 @@ u16 AcceleratorGetSample()
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
+template <typename InputCallback>
+u32 ResampleAudio(InputCallback&& input_callback, s16* output, u32 count, s16* last_samples,
                   u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
 {
   int read_samples_count = 0;
@@ -351,6 +395,23 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
   return curr_pos;
 }
 
+// Returns how many input samples ResampleAudio reads to produce <count>
+// output samples.
+u32 GetResampleInputCount(u32 count, u32 curr_pos, u32 ratio, int srctype)
+{
+  if (srctype != SRCTYPE_LINEAR && srctype != SRCTYPE_POLYPHASE)
+    return count;
+
+  u32 input_count = 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    curr_pos += ratio;
+    input_count += curr_pos >> 16;
+    curr_pos &= 0xFFFF;
+  }
+  return input_count;
+}
+
 // Read <count> input samples from ARAM, decoding and converting rate
 // if required.
 void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
@@ -359,9 +420,11 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+  const u32 ratio = HILO_TO_32(pb.src.ratio);
+  AcceleratorBlockReader reader(
+      GetResampleInputCount(count, pb.src.cur_addr_frac, ratio, pb.src_type));
+  u32 curr_pos = ResampleAudio(reader, samples, count, pb.src.last_samples, pb.src.cur_addr_frac,
+                               ratio, pb.src_type, coeffs);
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -372,30 +435,77 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
   pb.adpcm.pred_scale = s_accelerator->GetPredScale();
 }
 
+// Multiply samples by a 1.15 volume, which is incremented by <volume_delta>
+// after each sample, and clamp the results to [-32767, 32767].
+void ApplyVolume(const s16* input, s16* output, u32 count, u16& volume, u16 volume_delta)
+{
+  u32 i = 0;
+
+  // The product of a sample and a volume always fits in 32 bits, so both
+  // vector versions give the same results as the scalar loop.
+#ifdef _M_X86
+  __m128i vol = _mm_add_epi16(_mm_set1_epi16(static_cast<s16>(volume)),
+                              _mm_mullo_epi16(_mm_set1_epi16(static_cast<s16>(volume_delta)),
+                                              _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7)));
+  const __m128i vol_step = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const __m128i lo = _mm_mullo_epi16(in, vol);
+    // _mm_mulhi_epi16 treats the volume as signed, so correct the high half
+    // for volumes >= 0x8000.
+    const __m128i hi = _mm_add_epi16(_mm_mulhi_epi16(in, vol),
+                                     _mm_and_si128(_mm_srai_epi16(vol, 15), in));
+    const __m128i p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+    const __m128i p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                     _mm_max_epi16(_mm_packs_epi32(p0, p1), min_sample));
+    vol = _mm_add_epi16(vol, vol_step);
+  }
+#elif defined(_M_ARM_64)
+  const u16 initial_vol[4] = {volume, static_cast<u16>(volume + volume_delta),
+                              static_cast<u16>(volume + volume_delta * 2),
+                              static_cast<u16>(volume + volume_delta * 3)};
+  uint16x4_t vol = vld1_u16(initial_vol);
+  const uint16x4_t vol_step = vdup_n_u16(static_cast<u16>(volume_delta * 4));
+  const int32x4_t min_sample = vdupq_n_s32(-32767);
+  const int32x4_t max_sample = vdupq_n_s32(32767);
+  for (; i + 4 <= count; i += 4)
+  {
+    const int32x4_t in = vmovl_s16(vld1_s16(input + i));
+    const int32x4_t product = vmulq_s32(in, vreinterpretq_s32_u32(vmovl_u16(vol)));
+    const int32x4_t sample =
+        vminq_s32(vmaxq_s32(vshrq_n_s32(product, 15), min_sample), max_sample);
+    vst1_s16(output + i, vmovn_s32(sample));
+    vol = vadd_u16(vol, vol_step);
+  }
+#endif
+  volume += static_cast<u16>(i * volume_delta);
+
+  for (; i < count; ++i)
+  {
+    output[i] = std::clamp((input[i] * volume) >> 15, -32767, 32767);  // -32768 ?
+    volume += volume_delta;
+  }
+}
+
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
 {
-  u16& volume = pvol[0];
-  u16 volume_delta = pvol[1];
-
   // If volume ramping is disabled, set volume_delta to 0. That way, the
   // mixing loop can avoid testing if volume ramping is enabled at each step,
   // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
+  const u16 volume_delta = ramp ? pvol[1] : 0;
 
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+  s16 samples[MAX_SAMPLES_PER_FRAME];
+  ApplyVolume(input, samples, count, pvol[0], volume_delta);
 
-    out[i] += (s16)sample;
-    volume += volume_delta;
+  for (u32 i = 0; i < count; ++i)
+    out[i] += samples[i];
 
-    *dpop = (s16)sample;
-  }
+  if (count != 0)
+    *dpop = samples[count - 1];
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -409,8 +519,8 @@ s16 LowPassFilter(s16* samples, u32 count, s16 yn1, u16 a0, u16 b0)
 
 // Process 1ms of audio (for AX GC) or 3ms of audio (for AX Wii) from a PB and
 // mix it to the output buffers.
-void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl mctrl,
-                  const s16* coeffs)
+[[maybe_unused]] void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count,
+                                   AXMixControl mctrl, const s16* coeffs)
 {
   // If the voice is not running, nothing to do.
   if (!pb.running)
@@ -421,12 +531,7 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
-    samples[i] = std::clamp(((s32)samples[i] * pb.vol_env.cur_volume) >> 15, -32767,
-                            32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  ApplyVolume(samples, samples, count, pb.vol_env.cur_volume, pb.vol_env.cur_volume_delta);
 
   // Optionally, execute a low pass filter
   // TODO: LPF code is currently broken, causing Super Monkey Ball sound
@@ -0,0 +1,109 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HW/DSPHLE/UCodes/AXVoiceWorkers.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include "Common/Thread.h"
+
+namespace DSP::HLE
+{
+AXVoiceWorkers::AXVoiceWorkers(u32 num_workers) : m_workers(std::max<u32>(num_workers, 1))
+{
+  for (u32 i = 1; i < m_workers.size(); ++i)
+    m_threads.emplace_back(&AXVoiceWorkers::ThreadLoop, this, i);
+}
+
+AXVoiceWorkers::~AXVoiceWorkers()
+{
+  {
+    std::lock_guard lk(m_lock);
+    m_shutdown = true;
+  }
+  m_work_available.notify_all();
+  for (std::thread& thread : m_threads)
+    thread.join();
+}
+
+void AXVoiceWorkers::ProcessVoices(u32 num_voices, const std::vector<MixBuffer>& buffers,
+                                   const std::function<void(u32, int* const*)>& process)
+{
+  {
+    std::lock_guard lk(m_lock);
+    m_num_voices = num_voices;
+    m_buffers = &buffers;
+    m_process = &process;
+    m_pending_workers = static_cast<u32>(m_threads.size());
+    m_generation++;
+  }
+  m_work_available.notify_all();
+
+  RunWorker(0);
+
+  std::unique_lock lk(m_lock);
+  m_work_done.wait(lk, [this] { return m_pending_workers == 0; });
+
+  for (const Worker& worker : m_workers)
+  {
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+      const int* samples = worker.buffers[i];
+      for (u32 j = 0; j < buffers[i].size; ++j)
+        buffers[i].samples[j] += samples[j];
+    }
+  }
+}
+
+void AXVoiceWorkers::ThreadLoop(u32 worker_index)
+{
+  Common::SetCurrentThreadName(fmt::format("AX voice worker {}", worker_index).c_str());
+
+  u64 last_generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock lk(m_lock);
+      m_work_available.wait(lk, [&] { return m_shutdown || m_generation != last_generation; });
+      if (m_shutdown)
+        return;
+      last_generation = m_generation;
+    }
+
+    RunWorker(worker_index);
+
+    {
+      std::lock_guard lk(m_lock);
+      m_pending_workers--;
+    }
+    m_work_done.notify_one();
+  }
+}
+
+void AXVoiceWorkers::RunWorker(u32 worker_index)
+{
+  Worker& worker = m_workers[worker_index];
+
+  size_t total_size = 0;
+  for (const MixBuffer& buffer : *m_buffers)
+    total_size += buffer.size;
+  worker.storage.assign(total_size, 0);
+  worker.buffers.clear();
+  int* samples = worker.storage.data();
+  for (const MixBuffer& buffer : *m_buffers)
+  {
+    worker.buffers.push_back(samples);
+    samples += buffer.size;
+  }
+
+  // Workers take contiguous ranges of voices, so that each one only touches a part of the list.
+  const u32 num_workers = static_cast<u32>(m_workers.size());
+  const u32 begin = static_cast<u32>(u64{m_num_voices} * worker_index / num_workers);
+  const u32 end = static_cast<u32>(u64{m_num_voices} * (worker_index + 1) / num_workers);
+  for (u32 voice = begin; voice < end; ++voice)
+    (*m_process)(voice, worker.buffers.data());
+}
+}  // namespace DSP::HLE
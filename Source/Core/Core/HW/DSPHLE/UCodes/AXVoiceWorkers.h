@@ -0,0 +1,74 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace DSP::HLE
+{
+// A small pool of threads used to process the voices of an AX PB list in parallel.
+//
+// Each worker mixes its voices into its own zeroed copy of the mix buffers, which are added to
+// the real buffers once all voices are done. Integer additions give the same result in any order,
+// so the output is the same as processing the voices one after the other, whatever the number of
+// threads is.
+class AXVoiceWorkers
+{
+public:
+  struct MixBuffer
+  {
+    int* samples;
+    u32 size;
+  };
+
+  // PB lists longer than this are processed serially. They most likely loop, in which case
+  // processing them would never end anyway.
+  static constexpr u32 MAX_VOICES = 4096;
+
+  // The calling thread is used as one of the workers, so this starts num_workers - 1 threads.
+  explicit AXVoiceWorkers(u32 num_workers);
+  ~AXVoiceWorkers();
+
+  AXVoiceWorkers(const AXVoiceWorkers&) = delete;
+  AXVoiceWorkers& operator=(const AXVoiceWorkers&) = delete;
+
+  // Calls process(voice, buffers) for every voice in [0, num_voices), where buffers holds the
+  // private copies of the given mix buffers of the worker, in the same order. Returns once all
+  // voices have been processed and mixed into the given buffers.
+  void ProcessVoices(u32 num_voices, const std::vector<MixBuffer>& buffers,
+                     const std::function<void(u32 voice, int* const* buffers)>& process);
+
+private:
+  struct Worker
+  {
+    std::vector<int> storage;
+    std::vector<int*> buffers;
+  };
+
+  void ThreadLoop(u32 worker_index);
+  void RunWorker(u32 worker_index);
+
+  std::vector<Worker> m_workers;
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_lock;
+  std::condition_variable m_work_available;
+  std::condition_variable m_work_done;
+  u64 m_generation = 0;
+  u32 m_pending_workers = 0;
+  bool m_shutdown = false;
+
+  // Parameters of the current ProcessVoices call.
+  u32 m_num_voices = 0;
+  const std::vector<MixBuffer>* m_buffers = nullptr;
+  const std::function<void(u32, int* const*)>* m_process = nullptr;
+};
+}  // namespace DSP::HLE
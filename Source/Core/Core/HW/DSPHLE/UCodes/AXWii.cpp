@@ -8,6 +8,8 @@
 
 #include <algorithm>
 #include <array>
+#include <iterator>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -17,6 +19,7 @@
 #include "Core/HW/DSPHLE/MailHandler.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/DSPHLE/UCodes/AXVoice.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceWorkers.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 
 namespace DSP::HLE
@@ -442,19 +445,18 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPBWii pb;
+  const AXBuffers buffers = {{m_samples_left,      m_samples_right,      m_samples_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
+                              m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
+                              m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
+                              m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
+                              m_samples_wm3,       m_samples_aux3}};
 
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_left,      m_samples_right,      m_samples_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
-                          m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
-                          m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
-                          m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
-                          m_samples_wm3,       m_samples_aux3}};
-
-    ReadPB(pb_addr, pb, m_crc);
+  // Processes a PB, mixing it to the given buffers. Returns the address of the next PB.
+  const auto process_pb = [this](u32 addr, AXBuffers voice_buffers) {
+    AXPBWii pb;
+    ReadPB(addr, pb, m_crc);
 
     u16 num_updates[3];
     u16 updates[1024];
@@ -464,24 +466,68 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
       for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
       {
         ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
-        ProcessVoice(pb, buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+        ProcessVoice(pb, voice_buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                      m_coeffs_available ? m_coeffs : nullptr);
 
         // Forward the buffers
-        for (auto& ptr : buffers.ptrs)
+        for (auto& ptr : voice_buffers.ptrs)
           ptr += spms;
       }
       ReinjectUpdatesFields(pb, num_updates, updates_addr);
     }
     else
     {
-      ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+      ProcessVoice(pb, voice_buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                    m_coeffs_available ? m_coeffs : nullptr);
     }
 
-    WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
+    WritePB(addr, pb, m_crc);
+    return HILO_TO_32(pb.next_pb);
+  };
+
+  // Lists the PBs to process them in parallel. Returns false if they have to be processed
+  // serially.
+  const auto list_pbs = [this](u32 addr, std::vector<u32>* pb_addrs) {
+    // Old versions apply updates every millisecond, and forward the Wii Remote buffers past their
+    // end while doing so. Only the serial path writes to the same places.
+    if (m_old_axwii)
+      return false;
+
+    while (addr)
+    {
+      if (pb_addrs->size() == AXVoiceWorkers::MAX_VOICES)
+        return false;
+
+      AXPBWii pb;
+      ReadPB(addr, pb, m_crc);
+      pb_addrs->push_back(addr);
+      addr = HILO_TO_32(pb.next_pb);
+    }
+    return true;
+  };
+
+  std::vector<u32> pb_addrs;
+  if (m_voice_workers && list_pbs(pb_addr, &pb_addrs))
+  {
+    std::vector<AXVoiceWorkers::MixBuffer> mix_buffers;
+    for (size_t i = 0; i < std::size(buffers.ptrs); ++i)
+    {
+      // The first 12 buffers are the main and AUX ones, followed by the Wii Remote ones.
+      mix_buffers.push_back({buffers.ptrs[i], i < 12 ? spms * 3 : 6 * 3});
+    }
+
+    m_voice_workers->ProcessVoices(static_cast<u32>(pb_addrs.size()), mix_buffers,
+                                   [&](u32 voice, int* const* worker_buffers) {
+                                     AXBuffers voice_buffers;
+                                     std::copy_n(worker_buffers, std::size(voice_buffers.ptrs),
+                                                 voice_buffers.ptrs);
+                                     process_pb(pb_addrs[voice], voice_buffers);
+                                   });
+    return;
   }
+
+  while (pb_addr)
+    pb_addr = process_pb(pb_addr, buffers);
 }
 
 void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume)
@@ -6,8 +6,15 @@
 
 #include <algorithm>
 #include <array>
+#include <limits>
 #include <map>
 
+#ifdef _M_X86
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -964,6 +971,215 @@ struct ReverbPB
 };
 #pragma pack(pop)
 
+namespace ZeldaMixing
+{
+namespace
+{
+#ifdef _M_X86
+// Multiplies signed samples by an unsigned 16-bit volume, shifts the 32-bit products right and
+// saturates them back to 16 bits.
+__m128i MultiplyAndShift(__m128i samples, u16 vol, __m128i shift)
+{
+  const __m128i volumes = _mm_set1_epi16(static_cast<s16>(vol));
+  const __m128i low = _mm_mullo_epi16(samples, volumes);
+  __m128i high = _mm_mulhi_epi16(samples, volumes);
+  // _mm_mulhi_epi16 treats the volume as signed, which is off by 0x10000 when its MSB is set.
+  if (vol & 0x8000)
+    high = _mm_add_epi16(high, samples);
+  const __m128i products_low = _mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift);
+  const __m128i products_high = _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift);
+  return _mm_packs_epi32(products_low, products_high);
+}
+#elif defined(_M_ARM_64)
+int16x8_t MultiplyAndShift(int16x8_t samples, u16 vol, int32x4_t shift)
+{
+  const int32x4_t volumes = vdupq_n_s32(vol);
+  const int32x4_t products_low =
+      vshlq_s32(vmulq_s32(vmovl_s16(vget_low_s16(samples)), volumes), shift);
+  const int32x4_t products_high = vshlq_s32(vmulq_s32(vmovl_high_s16(samples), volumes), shift);
+  return vcombine_s16(vqmovn_s32(products_low), vqmovn_s32(products_high));
+}
+#endif
+}  // namespace
+
+void ApplyVolumeInPlace(s16* buf, size_t count, u16 vol, u32 int_bits)
+{
+  const u32 shift = 16 - int_bits;
+  size_t i = 0;
+#ifdef _M_X86
+  const __m128i shift_vector = _mm_cvtsi32_si128(shift);
+  for (; i < (count & ~size_t{7}); i += 8)
+  {
+    __m128i* samples = reinterpret_cast<__m128i*>(buf + i);
+    _mm_storeu_si128(samples, MultiplyAndShift(_mm_loadu_si128(samples), vol, shift_vector));
+  }
+#elif defined(_M_ARM_64)
+  const int32x4_t shift_vector = vdupq_n_s32(-static_cast<s32>(shift));
+  for (; i < (count & ~size_t{7}); i += 8)
+    vst1q_s16(buf + i, MultiplyAndShift(vld1q_s16(buf + i), vol, shift_vector));
+#endif
+  for (; i < count; ++i)
+  {
+    s32 tmp = (u32)buf[i] * (u32)vol;
+    tmp >>= shift;
+
+    buf[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
+  }
+}
+
+s32 AddBuffersWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step)
+{
+  // The volume wraps around like it would in a DSP register.
+  u32 volume = static_cast<u32>(vol);
+  size_t i = 0;
+#ifdef _M_X86
+  __m128i volumes_low =
+      _mm_setr_epi32(static_cast<s32>(volume), static_cast<s32>(volume + step),
+                     static_cast<s32>(volume + 2u * step), static_cast<s32>(volume + 3u * step));
+  __m128i volumes_high = _mm_add_epi32(volumes_low, _mm_set1_epi32(static_cast<s32>(4u * step)));
+  const __m128i volumes_step = _mm_set1_epi32(static_cast<s32>(8u * step));
+  for (; i < (count & ~size_t{7}); i += 8)
+  {
+    const __m128i volumes = _mm_packs_epi32(_mm_srai_epi32(volumes_low, 16),
+                                            _mm_srai_epi32(volumes_high, 16));
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), _mm_mulhi_epi16(volumes, samples)));
+    volumes_low = _mm_add_epi32(volumes_low, volumes_step);
+    volumes_high = _mm_add_epi32(volumes_high, volumes_step);
+  }
+  volume += static_cast<u32>(i) * step;
+#elif defined(_M_ARM_64)
+  const u32 initial[4] = {volume, volume + step, volume + 2u * step, volume + 3u * step};
+  int32x4_t volumes_low = vreinterpretq_s32_u32(vld1q_u32(initial));
+  int32x4_t volumes_high = vaddq_s32(volumes_low, vdupq_n_s32(static_cast<s32>(4u * step)));
+  const int32x4_t volumes_step = vdupq_n_s32(static_cast<s32>(8u * step));
+  for (; i < (count & ~size_t{7}); i += 8)
+  {
+    const int16x4_t volumes_l = vshrn_n_s32(volumes_low, 16);
+    const int16x4_t volumes_h = vshrn_n_s32(volumes_high, 16);
+    const int16x8_t samples = vld1q_s16(src + i);
+    const int16x8_t mixed =
+        vcombine_s16(vshrn_n_s32(vmull_s16(volumes_l, vget_low_s16(samples)), 16),
+                     vshrn_n_s32(vmull_s16(volumes_h, vget_high_s16(samples)), 16));
+    vst1q_s16(dst + i, vaddq_s16(vld1q_s16(dst + i), mixed));
+    volumes_low = vaddq_s32(volumes_low, volumes_step);
+    volumes_high = vaddq_s32(volumes_high, volumes_step);
+  }
+  volume += static_cast<u32>(i) * step;
+#endif
+  for (; i < count; ++i)
+  {
+    dst[i] += ((static_cast<s32>(volume) >> 16) * src[i]) >> 16;
+    volume += step;
+  }
+
+  return static_cast<s32>(volume);
+}
+
+void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  size_t i = 0;
+#ifdef _M_X86
+  const __m128i shift = _mm_cvtsi32_si128(15);
+  for (; i < (count & ~size_t{7}); i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(out,
+                     _mm_add_epi16(_mm_loadu_si128(out), MultiplyAndShift(samples, vol, shift)));
+  }
+#elif defined(_M_ARM_64)
+  const int32x4_t shift = vdupq_n_s32(-15);
+  for (; i < (count & ~size_t{7}); i += 8)
+  {
+    const int16x8_t mixed = MultiplyAndShift(vld1q_s16(src + i), vol, shift);
+    vst1q_s16(dst + i, vaddq_s16(vld1q_s16(dst + i), mixed));
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    s32 vol_src = ((s32)src[i] * (s32)vol) >> 15;
+    dst[i] += std::clamp(vol_src, -0x8000, 0x7FFF);
+  }
+}
+
+void ApplyFilterInPlace(s16* buf, size_t count, const s16* coeffs)
+{
+  // Each output sample only depends on input samples at and after its own position, so
+  // filtering forwards in place is fine.
+#ifdef _M_X86
+  const __m128i taps = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coeffs));
+  for (size_t i = 0; i < count; ++i)
+  {
+    __m128i sum =
+        _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i)), taps);
+    sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+    sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+    buf[i] = std::clamp(_mm_cvtsi128_si32(sum) >> 15, -0x8000, 0x7FFF);
+  }
+#elif defined(_M_ARM_64)
+  const int16x8_t taps = vld1q_s16(coeffs);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const int16x8_t samples = vld1q_s16(buf + i);
+    const int32x4_t products =
+        vmlal_high_s16(vmull_s16(vget_low_s16(samples), vget_low_s16(taps)), samples, taps);
+    buf[i] = std::clamp(vaddvq_s32(products) >> 15, -0x8000, 0x7FFF);
+  }
+#else
+  for (size_t i = 0; i < count; ++i)
+  {
+    // The sum wraps around like the 32-bit additions of the vector paths.
+    u32 sum = 0;
+    for (size_t j = 0; j < 8; ++j)
+      sum += static_cast<u32>(buf[i + j] * coeffs[j]);
+    buf[i] = std::clamp(static_cast<s32>(sum) >> 15, -0x8000, 0x7FFF);
+  }
+#endif
+}
+
+u32 Resample(const s16* src, s16* dst, size_t count, u32 pos, u32 ratio, const s16* coeffs)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    // We have 0x40 * 4 coeffs that need to be selected based on the
+    // most significant bits of the fractional part of the position. 12
+    // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
+    // consecutive coeffs.
+    const s16* sample_coeffs = &coeffs[((pos & 0xFFF) >> 6) * 4];
+    const s16* input = &src[pos >> 12];
+
+#ifdef _M_X86
+    const __m128i sums =
+        _mm_madd_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input)),
+                       _mm_loadl_epi64(reinterpret_cast<const __m128i*>(sample_coeffs)));
+    // Each lane holds the sum of two products. It can only overflow for 0x8000 * 0x8000 twice,
+    // which is the only way to end up with INT_MIN.
+    const auto widen = [](s32 sum) -> s64 {
+      return sum == std::numeric_limits<s32>::min() ? -s64{sum} : sum;
+    };
+    s64 dst_sample_unclamped = widen(_mm_cvtsi128_si32(sums)) +
+                               widen(_mm_cvtsi128_si32(_mm_srli_si128(sums, 4)));
+    dst_sample_unclamped = (dst_sample_unclamped * 2) >> 16;
+#elif defined(_M_ARM_64)
+    const int32x4_t products = vmull_s16(vld1_s16(input), vld1_s16(sample_coeffs));
+    s64 dst_sample_unclamped = (vaddvq_s64(vpaddlq_s32(products)) * 2) >> 16;
+#else
+    s64 dst_sample_unclamped = 0;
+    for (size_t j = 0; j < 4; ++j)
+      dst_sample_unclamped += (s64)2 * sample_coeffs[j] * input[j];
+    dst_sample_unclamped >>= 16;
+#endif
+
+    dst[i] = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
+
+    pos += ratio;
+  }
+  return pos;
+}
+}  // namespace ZeldaMixing
+
 void ZeldaAudioRenderer::PrepareFrame()
 {
   if (m_prepared)
@@ -1077,16 +1293,9 @@ void ZeldaAudioRenderer::ApplyReverb(bool post_rendering)
       for (u16 i = 0; i < 8; ++i)
         (*last8_samples_buffers[rpb_idx])[i] = buffer[0x50 + i];
 
+      // Filter the buffer using provided coefficients.
       auto ApplyFilter = [&]() {
-        // Filter the buffer using provided coefficients.
-        for (u16 i = 0; i < 0x50; ++i)
-        {
-          s32 sample = 0;
-          for (u16 j = 0; j < 8; ++j)
-            sample += (s32)buffer[i + j] * rpb.filter_coeffs[j];
-          sample >>= 15;
-          buffer[i] = std::clamp(sample, -0x8000, 0x7FFF);
-        }
+        ZeldaMixing::ApplyFilterInPlace(buffer.data(), 0x50, rpb.filter_coeffs);
       };
 
       // LSB set -> pre-filtering.
@@ -1510,25 +1719,8 @@ void ZeldaAudioRenderer::Resample(VPB* vpb, const s16* src, MixingBuffer* dst)
   }
   else
   {
-    for (auto& dst_sample : *dst)
-    {
-      // We have 0x40 * 4 coeffs that need to be selected based on the
-      // most significant bits of the fractional part of the position. 12
-      // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
-      // consecutive coeffs.
-      u32 coeffs_idx = ((pos & 0xFFF) >> 6) * 4;
-      const s16* coeffs = &m_resampling_coeffs[coeffs_idx];
-      const s16* input = &src[pos >> 12];
-
-      s64 dst_sample_unclamped = 0;
-      for (size_t i = 0; i < 4; ++i)
-        dst_sample_unclamped += (s64)2 * coeffs[i] * input[i];
-      dst_sample_unclamped >>= 16;
-
-      dst_sample = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
-
-      pos += ratio;
-    }
+    pos = ZeldaMixing::Resample(src, dst->data(), dst->size(), pos, ratio,
+                                m_resampling_coeffs.data());
   }
 
   for (u32 i = 0; i < 4; ++i)
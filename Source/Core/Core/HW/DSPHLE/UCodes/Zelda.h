@@ -4,8 +4,8 @@
 
 #pragma once
 
-#include <algorithm>
 #include <array>
+#include <cstddef>
 
 #include "Common/CommonTypes.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
@@ -14,6 +14,31 @@ namespace DSP::HLE
 {
 class DSPHLE;
 
+// Buffer operations of the Zelda audio renderer. They have SSE2 and NEON implementations which
+// give the same results as processing the buffers one sample at a time.
+namespace ZeldaMixing
+{
+// Applies a fixed point volume with int_bits integer bits (1.15 or 4.12 in the DAC UCode) to a
+// buffer, saturating the results.
+void ApplyVolumeInPlace(s16* buf, size_t count, u16 vol, u32 int_bits);
+
+// Mixes src into dst while applying a volume in 1.31 format, which is incremented by step after
+// each sample. Returns the volume after the last sample.
+s32 AddBuffersWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step);
+
+// Mixes src into dst while applying a volume in 1.15 format.
+void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol);
+
+// Applies an 8-tap filter in place: buf[i] = sum(buf[i + j] * coeffs[j]) >> 15, saturated. buf
+// must hold count + 7 samples.
+void ApplyFilterInPlace(s16* buf, size_t count, const s16* coeffs);
+
+// Resamples src into dst with a 4-tap filter. Positions and ratio are in 20.12 format, and the 6
+// most significant bits of the fractional part of the position select 4 of the 0x100 coeffs.
+// Returns the position after the last sample.
+u32 Resample(const s16* src, s16* dst, size_t count, u32 pos, u32 ratio, const s16* coeffs);
+}  // namespace ZeldaMixing
+
 class ZeldaAudioRenderer
 {
 public:
@@ -47,13 +72,7 @@ private:
   template <size_t N, size_t B>
   void ApplyVolumeInPlace(std::array<s16, N>* buf, u16 vol)
   {
-    for (size_t i = 0; i < N; ++i)
-    {
-      s32 tmp = (u32)(*buf)[i] * (u32)vol;
-      tmp >>= 16 - B;
-
-      (*buf)[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
-    }
+    ZeldaMixing::ApplyVolumeInPlace(buf->data(), N, vol, B);
   }
   template <size_t N>
   void ApplyVolumeInPlace_1_15(std::array<s16, N>* buf, u16 vol)
@@ -78,24 +97,14 @@ private:
     if (!vol && !step)
       return vol;
 
-    for (size_t i = 0; i < N; ++i)
-    {
-      (*dst)[i] += ((vol >> 16) * src[i]) >> 16;
-      vol += step;
-    }
-
-    return vol;
+    return ZeldaMixing::AddBuffersWithVolumeRamp(dst->data(), src.data(), N, vol, step);
   }
 
   // Does not use std::array because it needs to be able to process partial
   // buffers. Volume is in 1.15 format.
   void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
   {
-    while (count--)
-    {
-      s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
-      *dst++ += std::clamp(vol_src, -0x8000, 0x7FFF);
-    }
+    ZeldaMixing::AddBuffersWithVolume(dst, src, count, vol);
   }
 
   // Whether the frame needs to be prepared or not.
@@ -5,6 +5,7 @@
 #include "Core/HW/DVD/DVDInterface.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <string>
@@ -147,8 +148,6 @@ static UDICR s_DICR;
 static u32 s_DIIMMBUF;
 static UDICFG s_DICFG;
 
-static StreamADPCM::ADPCMDecoder s_adpcm_decoder;
-
 // DTK
 static bool s_stream = false;
 static bool s_stop_at_track_end = false;
@@ -158,6 +157,8 @@ static u32 s_current_length;
 static u64 s_next_start;
 static u32 s_next_length;
 static u32 s_pending_samples;
+// The DVD thread decodes DTK audio, so resetting its filter is passed along with the next read.
+static bool s_reset_dtk_filter;
 static bool s_enable_dtk = false;
 static u8 s_dtk_buffer_length = 0;  // TODO: figure out how this affects the regular buffer
 
@@ -220,6 +221,7 @@ void DoState(PointerWrap& p)
   p.Do(s_next_start);
   p.Do(s_next_length);
   p.Do(s_pending_samples);
+  p.Do(s_reset_dtk_filter);
   p.Do(s_enable_dtk);
   p.Do(s_dtk_buffer_length);
 
@@ -234,27 +236,6 @@ void DoState(PointerWrap& p)
   p.Do(s_disc_path_to_insert);
 
   DVDThread::DoState(p);
-
-  s_adpcm_decoder.DoState(p);
-}
-
-static size_t ProcessDTKSamples(std::vector<s16>* temp_pcm, const std::vector<u8>& audio_data)
-{
-  size_t samples_processed = 0;
-  size_t bytes_processed = 0;
-  while (samples_processed < temp_pcm->size() / 2 && bytes_processed < audio_data.size())
-  {
-    s_adpcm_decoder.DecodeBlock(&(*temp_pcm)[samples_processed * 2], &audio_data[bytes_processed]);
-    for (size_t i = 0; i < StreamADPCM::SAMPLES_PER_BLOCK * 2; ++i)
-    {
-      // TODO: Fix the mixer so it can accept non-byte-swapped samples.
-      s16* sample = &(*temp_pcm)[samples_processed * 2 + i];
-      *sample = Common::swap16(*sample);
-    }
-    samples_processed += StreamADPCM::SAMPLES_PER_BLOCK;
-    bytes_processed += StreamADPCM::ONE_BLOCK_SIZE;
-  }
-  return samples_processed;
 }
 
 static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
@@ -282,7 +263,7 @@ static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
         break;
       }
 
-      s_adpcm_decoder.ResetFilter();
+      s_reset_dtk_filter = true;
     }
 
     s_audio_position += StreamADPCM::ONE_BLOCK_SIZE;
@@ -307,9 +288,10 @@ static void DTKStreamingCallback(DIInterruptType interrupt_type, const std::vect
 
   if (interrupt_type == DIInterruptType::TCINT)
   {
-    // Send audio to the mixer.
+    // Send audio to the mixer. The DVD thread has already decoded it.
     std::vector<s16> temp_pcm(s_pending_samples * 2, 0);
-    ProcessDTKSamples(&temp_pcm, audio_data);
+    std::memcpy(temp_pcm.data(), audio_data.data(),
+                std::min(audio_data.size(), temp_pcm.size() * sizeof(s16)));
     g_sound_stream->GetMixer()->PushStreamingSamples(temp_pcm.data(), s_pending_samples);
 
     if (s_stream && AudioInterface::IsPlaying())
@@ -334,8 +316,8 @@ static void DTKStreamingCallback(DIInterruptType interrupt_type, const std::vect
   ticks_to_dtk -= cycles_late;
   if (read_length > 0)
   {
-    DVDThread::StartRead(read_offset, read_length, DiscIO::PARTITION_NONE, ReplyType::DTK,
-                         ticks_to_dtk);
+    DVDThread::StartDTKRead(read_offset, read_length, s_reset_dtk_filter, ticks_to_dtk);
+    s_reset_dtk_filter = false;
   }
   else
   {
@@ -388,6 +370,7 @@ void ResetDrive(bool spinup)
   s_current_start = 0;
   s_current_length = 0;
   s_pending_samples = 0;
+  s_reset_dtk_filter = false;
   s_enable_dtk = false;
   s_dtk_buffer_length = 0;
 
@@ -1032,7 +1015,7 @@ void ExecuteCommand(ReplyType reply_type)
           s_current_start = s_next_start;
           s_current_length = s_next_length;
           s_audio_position = s_current_start;
-          s_adpcm_decoder.ResetFilter();
+          s_reset_dtk_filter = true;
           s_stream = true;
         }
       }
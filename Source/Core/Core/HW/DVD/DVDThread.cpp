@@ -4,6 +4,7 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <cstring>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -19,6 +20,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/SPSCQueue.h"
+#include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
@@ -28,6 +30,7 @@
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/DVD/FileMonitor.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/StreamADPCM.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/IOS/ES/Formats.h"
 
@@ -44,6 +47,11 @@ struct ReadRequest
   u32 length;
   DiscIO::Partition partition;
 
+  // DTK audio is decoded on the DVD thread. The result then contains the decoded samples instead
+  // of the data which was read. The filter is reset before decoding when a new track starts.
+  bool decode_dtk_audio;
+  bool reset_dtk_filter;
+
   // This determines which code DVDInterface will run to reply
   // to the emulated software. We can't use callbacks,
   // because function pointers can't be stored in savestates.
@@ -70,7 +78,8 @@ static void WaitUntilIdle();
 
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                               const DiscIO::Partition& partition,
-                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion);
+                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion,
+                              bool decode_dtk_audio = false, bool reset_dtk_filter = false);
 
 static void FinishRead(u64 id, s64 cycles_late);
 static CoreTiming::EventType* s_finish_read;
@@ -88,6 +97,9 @@ static std::map<u64, ReadResult> s_result_map;
 
 static std::unique_ptr<DiscIO::Volume> s_disc;
 
+// Only used by the DVD thread, or by the CPU thread while the DVD thread is idle
+static StreamADPCM::ADPCMDecoder s_dtk_decoder;
+
 void Start()
 {
   s_finish_read = CoreTiming::RegisterEvent("FinishReadDVDThread", FinishRead);
@@ -96,6 +108,7 @@ void Start()
   s_result_queue_expanded.Reset();
   s_request_queue.Clear();
   s_result_queue.Clear();
+  s_dtk_decoder.ResetFilter();
 
   // This is reset on every launch for determinism, but it doesn't matter
   // much, because this will never get exposed to the emulated game.
@@ -147,6 +160,7 @@ void DoState(PointerWrap& p)
   // Both queues are now empty, so we don't need to savestate them.
   p.Do(s_result_map);
   p.Do(s_next_id);
+  s_dtk_decoder.DoState(p);
 
   // s_disc isn't savestated (because it points to files on the
   // local system). Instead, we check that the status of the disc
@@ -268,9 +282,16 @@ void StartReadToEmulatedRAM(u32 output_address, u64 dvd_offset, u32 length,
                     ticks_until_completion);
 }
 
+void StartDTKRead(u64 dvd_offset, u32 length, bool reset_filter, s64 ticks_until_completion)
+{
+  StartReadInternal(false, 0, dvd_offset, length, DiscIO::PARTITION_NONE,
+                    DVDInterface::ReplyType::DTK, ticks_until_completion, true, reset_filter);
+}
+
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                               const DiscIO::Partition& partition,
-                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion)
+                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion,
+                              bool decode_dtk_audio, bool reset_dtk_filter)
 {
   ASSERT(Core::IsCPUThread());
 
@@ -281,6 +302,8 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
   request.dvd_offset = dvd_offset;
   request.length = length;
   request.partition = partition;
+  request.decode_dtk_audio = decode_dtk_audio;
+  request.reset_dtk_filter = reset_dtk_filter;
   request.reply_type = reply_type;
 
   u64 id = s_next_id++;
@@ -295,6 +318,15 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
   CoreTiming::ScheduleEvent(ticks_until_completion, s_finish_read, id);
 }
 
+static u32 GetResultLength(const ReadRequest& request)
+{
+  if (!request.decode_dtk_audio)
+    return request.length;
+
+  return request.length / StreamADPCM::ONE_BLOCK_SIZE * StreamADPCM::SAMPLES_PER_BLOCK * 2 *
+         sizeof(s16);
+}
+
 static void FinishRead(u64 id, s64 cycles_late)
 {
   // We can't simply pop s_result_queue and always get the ReadResult
@@ -342,7 +374,7 @@ static void FinishRead(u64 id, s64 cycles_late)
                     (SystemTimers::GetTicksPerSecond() / 1000000));
 
   DVDInterface::DIInterruptType interrupt;
-  if (buffer.size() != request.length)
+  if (buffer.size() != GetResultLength(request))
   {
     PanicAlertFmtT("The disc could not be read (at {0:#x} - {1:#x}).", request.dvd_offset,
                    request.dvd_offset + request.length);
@@ -362,6 +394,21 @@ static void FinishRead(u64 id, s64 cycles_late)
   DVDInterface::FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
 }
 
+static std::vector<u8> DecodeDTKAudio(const std::vector<u8>& audio_data)
+{
+  const size_t block_count = audio_data.size() / StreamADPCM::ONE_BLOCK_SIZE;
+  std::vector<s16> pcm(block_count * StreamADPCM::SAMPLES_PER_BLOCK * 2);
+  s_dtk_decoder.DecodeBlocks(pcm.data(), audio_data.data(), block_count);
+
+  // TODO: Fix the mixer so it can accept non-byte-swapped samples.
+  for (s16& sample : pcm)
+    sample = Common::swap16(sample);
+
+  std::vector<u8> result(pcm.size() * sizeof(s16));
+  std::memcpy(result.data(), pcm.data(), result.size());
+  return result;
+}
+
 static void DVDThread()
 {
   Common::SetCurrentThreadName("DVD thread");
@@ -382,6 +429,13 @@ static void DVDThread()
       if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
         buffer.resize(0);
 
+      if (request.decode_dtk_audio)
+      {
+        if (request.reset_dtk_filter)
+          s_dtk_decoder.ResetFilter();
+        buffer = DecodeDTKAudio(buffer);
+      }
+
       request.realtime_done_us = Common::Timer::GetTimeUs();
 
       s_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
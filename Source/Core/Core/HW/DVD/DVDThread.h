@@ -60,4 +60,7 @@ void StartRead(u64 dvd_offset, u32 length, const DiscIO::Partition& partition,
 void StartReadToEmulatedRAM(u32 output_address, u64 dvd_offset, u32 length,
                             const DiscIO::Partition& partition, DVDInterface::ReplyType reply_type,
                             s64 ticks_until_completion);
+// Reads DTK audio and decodes it on the DVD thread. DVDInterface gets the decoded samples as
+// byte-swapped stereo s16 in place of the data which was read.
+void StartDTKRead(u64 dvd_offset, u32 length, bool reset_filter, s64 ticks_until_completion);
 }  // namespace DVDThread
@@ -13,27 +13,37 @@
 
 namespace StreamADPCM
 {
-static s16 ADPDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
+namespace
 {
-  s32 hist = 0;
-  switch (q >> 4)
+struct Filter
+{
+  s32 coef1;
+  s32 coef2;
+};
+
+// The filter is selected by the high nibble of the block header. Only the first 4 are defined,
+// the others don't use the history at all.
+constexpr Filter GetFilter(u8 header)
+{
+  switch (header >> 4)
   {
-  case 0:
-    hist = 0;
-    break;
   case 1:
-    hist = (hist1 * 0x3c);
-    break;
+    return {0x3c, 0};
   case 2:
-    hist = (hist1 * 0x73) - (hist2 * 0x34);
-    break;
+    return {0x73, 0x34};
   case 3:
-    hist = (hist1 * 0x62) - (hist2 * 0x37);
-    break;
+    return {0x62, 0x37};
+  default:
+    return {0, 0};
   }
+}
+
+s16 ADPDecodeSample(s32 bits, s32 shift, const Filter& filter, s32& hist1, s32& hist2)
+{
+  s32 hist = (hist1 * filter.coef1) - (hist2 * filter.coef2);
   hist = std::clamp((hist + 0x20) >> 6, -0x200000, 0x1fffff);
 
-  s32 cur = (((s16)(bits << 12) >> (q & 0xf)) << 6) + hist;
+  s32 cur = (((s16)(bits << 12) >> shift) << 6) + hist;
 
   hist2 = hist1;
   hist1 = cur;
@@ -43,6 +53,7 @@ static s16 ADPDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
 
   return (s16)cur;
 }
+}  // namespace
 
 void ADPCMDecoder::ResetFilter()
 {
@@ -62,12 +73,24 @@ void ADPCMDecoder::DoState(PointerWrap& p)
 
 void ADPCMDecoder::DecodeBlock(s16* pcm, const u8* adpcm)
 {
+  // The header selects the filter and shift of each channel for the whole block, so they are
+  // looked up once rather than for every sample.
+  const Filter left_filter = GetFilter(adpcm[0]);
+  const Filter right_filter = GetFilter(adpcm[1]);
+  const s32 left_shift = adpcm[0] & 0xf;
+  const s32 right_shift = adpcm[1] & 0xf;
+
+  const u8* data = adpcm + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK);
   for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
   {
-    pcm[i * 2] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] & 0xf, adpcm[0],
-                                 m_histl1, m_histl2);
-    pcm[i * 2 + 1] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] >> 4, adpcm[1],
-                                     m_histr1, m_histr2);
+    pcm[i * 2] = ADPDecodeSample(data[i] & 0xf, left_shift, left_filter, m_histl1, m_histl2);
+    pcm[i * 2 + 1] = ADPDecodeSample(data[i] >> 4, right_shift, right_filter, m_histr1, m_histr2);
   }
 }
+
+void ADPCMDecoder::DecodeBlocks(s16* pcm, const u8* adpcm, size_t block_count)
+{
+  for (size_t i = 0; i < block_count; ++i)
+    DecodeBlock(pcm + i * SAMPLES_PER_BLOCK * 2, adpcm + i * ONE_BLOCK_SIZE);
+}
 }  // namespace StreamADPCM
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "Common/CommonTypes.h"
 
 class PointerWrap;
@@ -24,6 +26,8 @@ public:
   void ResetFilter();
   void DoState(PointerWrap& p);
   void DecodeBlock(s16* pcm, const u8* adpcm);
+  // Decodes block_count consecutive blocks into block_count * SAMPLES_PER_BLOCK stereo samples.
+  void DecodeBlocks(s16* pcm, const u8* adpcm, size_t block_count);
 
 private:
   s32 m_histl1 = 0;
@@ -10,17 +10,21 @@
 #include <cstring>
 #include <signal.h>
 #include <string>
+#include <variant>
 #ifndef _WIN32
 #include <unistd.h>
 #else
 #include <Windows.h>
 #endif
 
+#include "AudioCommon/AudioCommon.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/Host.h"
 
 #include "UICommon/CommandLineParse.h"
@@ -29,6 +33,7 @@
 #endif
 #include "UICommon/UICommon.h"
 
+#include "VideoCommon/Benchmark.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 
@@ -131,6 +136,14 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+// Lifts the speed limit of the emulation that was just booted. The boot manager restores the
+// configured speed when emulation stops, so that the change doesn't end up in Dolphin.ini.
+static void DisableSpeedLimit()
+{
+  SConfig::GetInstance().m_EmulationSpeed = 0.0f;
+  BootManager::SetEmulationSpeedReset(true);
+}
+
 int main(int argc, char* argv[])
 {
   auto parser = CommandLineParse::CreateParser(CommandLineParse::ParserOptions::OmitGUIOptions);
@@ -152,6 +165,17 @@ int main(int argc, char* argv[])
             "win32"
 #endif
       });
+  parser->add_option("--benchmark")
+      .action("store")
+      .type("int")
+      .metavar("<count>")
+      .help("Play the FIFO log <count> times without a speed limit, then print frame times, "
+            "draw calls and shader compilations as JSON");
+  parser->add_option("--render-audio")
+      .action("store")
+      .metavar("<file>")
+      .help("Run without a speed limit and write the audio output of the DSP to the WAV file "
+            "<file> instead of playing it");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -216,6 +240,31 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  const bool benchmark = options.is_set("benchmark");
+  if (benchmark)
+  {
+    const int count = static_cast<int>(options.get("benchmark"));
+    if (count <= 0 || !boot || !std::holds_alternative<BootParameters::DFF>(boot->parameters))
+    {
+      fprintf(stderr, "A benchmark requires a FIFO log and a positive playback count.\n");
+      return 1;
+    }
+    FifoPlayer::GetInstance().SetPlaybackCount(static_cast<u32>(count));
+    FifoPlayer::GetInstance().SetFrameWrittenCallback(Benchmark::OnCPUFrame);
+    Benchmark::Start();
+  }
+
+  const bool render_audio = options.is_set("render_audio");
+  if (render_audio)
+  {
+    if (!game_specified)
+    {
+      fprintf(stderr, "Rendering audio requires a game to launch.\n");
+      return 1;
+    }
+    AudioCommon::SetAudioRenderPath(static_cast<const char*>(options.get("render_audio")));
+  }
+
   Core::SetOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_platform->Stop();
@@ -242,6 +291,9 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  if (benchmark || render_audio)
+    DisableSpeedLimit();
+
 #ifdef USE_DISCORD_PRESENCE
   Discord::UpdateDiscordPresence();
 #endif
@@ -253,5 +305,8 @@ int main(int argc, char* argv[])
   s_platform.reset();
   UICommon::Shutdown();
 
+  if (benchmark)
+    fputs(Benchmark::Stop().c_str(), stdout);
+
   return 0;
 }
@@ -13,6 +13,8 @@
 #include "VideoCommon/VideoConfig.h"
 
 static GLuint s_bbox_buffer_id;
+static GLuint s_readback_buffer_id;
+static GLsync s_readback_fence;
 
 namespace OGL
 {
@@ -26,6 +28,11 @@ void BoundingBox::Init()
   glBindBuffer(GL_SHADER_STORAGE_BUFFER, s_bbox_buffer_id);
   glBufferData(GL_SHADER_STORAGE_BUFFER, 4 * sizeof(s32), initial_values, GL_DYNAMIC_DRAW);
   glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, s_bbox_buffer_id);
+
+  glGenBuffers(1, &s_readback_buffer_id);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, s_readback_buffer_id);
+  glBufferData(GL_COPY_WRITE_BUFFER, 4 * sizeof(s32), initial_values, GL_STREAM_READ);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
 }
 
 void BoundingBox::Shutdown()
@@ -33,6 +40,12 @@ void BoundingBox::Shutdown()
   if (!g_ActiveConfig.backend_info.bSupportsBBox)
     return;
 
+  if (s_readback_fence)
+  {
+    glDeleteSync(s_readback_fence);
+    s_readback_fence = nullptr;
+  }
+  glDeleteBuffers(1, &s_readback_buffer_id);
   glDeleteBuffers(1, &s_bbox_buffer_id);
 }
 
@@ -75,4 +88,51 @@ int BoundingBox::Get(int index)
   glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
   return data;
 }
+
+void BoundingBox::RequestReadback()
+{
+  if (!g_ActiveConfig.backend_info.bSupportsBBox || s_readback_fence)
+    return;
+
+  // Make the writes of previous draws visible to the copy.
+  glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+  glBindBuffer(GL_COPY_READ_BUFFER, s_bbox_buffer_id);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, s_readback_buffer_id);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, 4 * sizeof(s32));
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  s_readback_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool BoundingBox::PollReadback(int* values)
+{
+  if (!s_readback_fence)
+    return false;
+
+  const GLenum status = glClientWaitSync(s_readback_fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+  if (status == GL_TIMEOUT_EXPIRED)
+    return false;
+
+  glDeleteSync(s_readback_fence);
+  s_readback_fence = nullptr;
+  if (status == GL_WAIT_FAILED)
+    return false;
+
+  glBindBuffer(GL_COPY_READ_BUFFER, s_readback_buffer_id);
+  if (!static_cast<Renderer*>(g_renderer.get())->IsGLES())
+  {
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, 4 * sizeof(s32), values);
+  }
+  else
+  {
+    void* ptr = glMapBufferRange(GL_COPY_READ_BUFFER, 0, 4 * sizeof(s32), GL_MAP_READ_BIT);
+    if (ptr)
+    {
+      memcpy(values, ptr, 4 * sizeof(s32));
+      glUnmapBuffer(GL_COPY_READ_BUFFER);
+    }
+  }
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  return true;
+}
 };  // namespace OGL
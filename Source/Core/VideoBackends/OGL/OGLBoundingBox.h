@@ -14,5 +14,10 @@ public:
 
   static void Set(int index, int value);
   static int Get(int index);
+
+  // Copies the bounding box to a staging buffer, unless a previous copy is still in flight.
+  static void RequestReadback();
+  // Returns the values of the last copy if the GPU has completed it.
+  static bool PollReadback(int* values);
 };
 };  // namespace OGL
@@ -883,6 +883,25 @@ void Renderer::BBoxWrite(int index, u16 value)
   BoundingBox::Set(index, swapped_value);
 }
 
+void Renderer::BBoxRequestReadback()
+{
+  BoundingBox::RequestReadback();
+}
+
+bool Renderer::BBoxPollReadback(std::array<u16, 4>* values)
+{
+  int raw_values[4];
+  if (!BoundingBox::PollReadback(raw_values))
+    return false;
+
+  // swap 2 and 3 for top/bottom, and flip them vertically
+  (*values)[0] = static_cast<u16>(raw_values[0]);
+  (*values)[1] = static_cast<u16>(raw_values[1]);
+  (*values)[2] = static_cast<u16>(EFB_HEIGHT - raw_values[3]);
+  (*values)[3] = static_cast<u16>(EFB_HEIGHT - raw_values[2]);
+  return true;
+}
+
 void Renderer::SetViewport(float x, float y, float width, float height, float near_depth,
                            float far_depth)
 {
@@ -128,6 +128,8 @@ public:
 
   u16 BBoxRead(int index) override;
   void BBoxWrite(int index, u16 value) override;
+  void BBoxRequestReadback() override;
+  bool BBoxPollReadback(std::array<u16, 4>* values) override;
 
   void BeginUtilityDrawing() override;
   void EndUtilityDrawing() override;
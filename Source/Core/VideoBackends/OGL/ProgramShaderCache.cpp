@@ -37,7 +37,6 @@
 
 namespace OGL
 {
-u32 ProgramShaderCache::s_ubo_buffer_size;
 s32 ProgramShaderCache::s_ubo_align = 1;
 GLuint ProgramShaderCache::s_attributeless_VBO = 0;
 GLuint ProgramShaderCache::s_attributeless_VAO = 0;
@@ -216,37 +215,38 @@ u32 ProgramShaderCache::GetUniformBufferAlignment()
   return s_ubo_align;
 }
 
+// Streams a single constant struct and binds it, so that changing the constants of one stage
+// doesn't re-upload the (much larger) constants of the other stages.
+static void UploadStageConstants(StreamBuffer* buffer, u32 align, GLuint index, const void* data,
+                                 u32 data_size)
+{
+  const u32 alloc_size = Common::AlignUp(data_size, align);
+  auto mapping = buffer->Map(alloc_size, align);
+  std::memcpy(mapping.first, data, data_size);
+  buffer->Unmap(alloc_size);
+  glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer->m_buffer, mapping.second, data_size);
+  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, data_size);
+}
+
 void ProgramShaderCache::UploadConstants()
 {
-  if (PixelShaderManager::dirty || VertexShaderManager::dirty || GeometryShaderManager::dirty)
+  if (PixelShaderManager::dirty)
   {
-    auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
-
-    memcpy(buffer.first, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-           &VertexShaderManager::constants, sizeof(VertexShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-               Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-           &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
-
-    s_buffer->Unmap(s_ubo_buffer_size);
-    glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second,
-                      sizeof(PixelShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-                      sizeof(VertexShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                          Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-                      sizeof(GeometryShaderConstants));
-
+    UploadStageConstants(s_buffer.get(), s_ubo_align, 1, &PixelShaderManager::constants,
+                         sizeof(PixelShaderConstants));
     PixelShaderManager::dirty = false;
+  }
+  if (VertexShaderManager::dirty)
+  {
+    UploadStageConstants(s_buffer.get(), s_ubo_align, 2, &VertexShaderManager::constants,
+                         sizeof(VertexShaderConstants));
     VertexShaderManager::dirty = false;
+  }
+  if (GeometryShaderManager::dirty)
+  {
+    UploadStageConstants(s_buffer.get(), s_ubo_align, 3, &GeometryShaderManager::constants,
+                         sizeof(GeometryShaderConstants));
     GeometryShaderManager::dirty = false;
-
-    ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, s_ubo_buffer_size);
   }
 }
 
@@ -434,11 +434,6 @@ void ProgramShaderCache::Init()
   // then the UBO will fail.
   glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &s_ubo_align);
 
-  s_ubo_buffer_size =
-      static_cast<u32>(Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                       Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align) +
-                       Common::AlignUp(sizeof(GeometryShaderConstants), s_ubo_align));
-
   // We multiply by *4*4 because we need to get down to basic machine units.
   // So multiply by four to get how many floats we have from vec4s
   // Then once more to get bytes
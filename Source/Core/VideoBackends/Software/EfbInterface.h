@@ -60,4 +60,7 @@ void EncodeXFB(u8* xfb_in_ram, u32 memory_stride, const MathUtil::Rectangle<int>
 u32 GetPerfQueryResult(PerfQueryType type);
 void ResetPerfQuery();
 void IncPerfCounterQuadCount(PerfQueryType type);
+// Adds the pixels counted by IncPerfCounterQuadCount on the calling thread to the perf query
+// results. Must be called by every thread which rasterized pixels before the results are read.
+void FlushPerfCounters();
 }  // namespace EfbInterface
@@ -5,12 +5,22 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Thread.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Tev.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
@@ -21,28 +31,88 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
-static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
+// Triangles are binned into tiles of the EFB, which are shaded in parallel. The tile size is a
+// multiple of BLOCK_SIZE, so a block always belongs to exactly one tile.
+static constexpr int TILE_SIZE = 32;
+static constexpr int TILES_X = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr int TILES_Y = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+static_assert(TILE_SIZE % BLOCK_SIZE == 0, "Blocks must not cross tile boundaries");
 
-static s32 vertex0X;
-static s32 vertex0Y;
-static float vertexOffsetX;
-static float vertexOffsetY;
+// Everything needed to rasterize a triangle, computed once by DrawTriangleFrontFace.
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
 
-static Tev tev;
-static RasterBlock rasterBlock;
+  s32 vertex0X;
+  s32 vertex0Y;
+  float vertexOffsetX;
+  float vertexOffsetY;
 
-void Init()
+  // Half-edge constants
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Bounding rectangle, in pixels. minx and miny are aligned to BLOCK_SIZE.
+  s32 minx, maxx, miny, maxy;
+};
+
+// State of a thread shading pixels. All EFB and statistics updates which aren't tied to a single
+// pixel are accumulated here, and applied once the batch is finished.
+struct RasterContext
 {
-  tev.Init();
+  u32 index = 0;
 
-  // Set initial z reference plane in the unlikely case that zfreeze is enabled when drawing the
-  // first primitive.
-  // TODO: This is just a guess!
-  ZSlope.dfdx = ZSlope.dfdy = 0.f;
-  ZSlope.f0 = 1.f;
+  Tev tev;
+  RasterBlock rasterBlock;
+
+  u32 rasterized_pixels = 0;
+  u32 tev_pixels_in = 0;
+  u32 tev_pixels_out = 0;
+
+  bool bbox_updated = false;
+  u16 bbox_left = 0;
+  u16 bbox_right = 0;
+  u16 bbox_top = 0;
+  u16 bbox_bottom = 0;
+};
+
+// Only changed when zfreeze is disabled, so the last z plane can be reused for frozen triangles.
+static Slope ZSlope;
+
+// s_contexts[0] belongs to the GPU thread, the others to the worker threads.
+static std::vector<std::unique_ptr<RasterContext>> s_contexts;
+static std::array<s16, 16> s_tev_konst_colors;
+
+static std::vector<TriangleSetup> s_triangles;
+static std::array<std::vector<u32>, TILES_X * TILES_Y> s_tile_bins;
+static std::atomic<u32> s_next_tile;
+
+static std::vector<std::thread> s_workers;
+static std::mutex s_workers_mutex;
+static std::condition_variable s_work_available;
+static std::condition_variable s_work_done;
+static std::function<void(RasterContext&)> s_work;
+static u64 s_work_generation = 0;
+static u32 s_busy_workers = 0;
+static bool s_workers_exit = false;
+
+static void CreateContexts(u32 count)
+{
+  while (s_contexts.size() < count)
+  {
+    auto& context = s_contexts.emplace_back(std::make_unique<RasterContext>());
+    context->index = static_cast<u32>(s_contexts.size() - 1);
+    context->tev.Init();
+    for (int reg = 0; reg < 4; reg++)
+    {
+      for (int comp = 0; comp < 4; comp++)
+        context->tev.SetRegColor(reg, comp, s_tev_konst_colors[reg * 4 + comp]);
+    }
+  }
 }
 
 // Returns approximation of log2(f) in s28.4
@@ -69,17 +139,19 @@ static inline int iround(float x)
 
 void SetTevReg(int reg, int comp, s16 color)
 {
-  tev.SetRegColor(reg, comp, color);
+  s_tev_konst_colors[reg * 4 + comp] = color;
+  for (auto& context : s_contexts)
+    context->tev.SetRegColor(reg, comp, color);
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(RasterContext& context, const TriangleSetup& tri, s32 x, s32 y, s32 xi, s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  context.rasterized_pixels++;
 
-  float dx = vertexOffsetX + (float)(x - vertex0X);
-  float dy = vertexOffsetY + (float)(y - vertex0Y);
+  float dx = tri.vertexOffsetX + (float)(x - tri.vertex0X);
+  float dy = tri.vertexOffsetY + (float)(y - tri.vertex0Y);
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(dx, dy), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(tri.ZSlope.GetValue(dx, dy), 0.0f, 16777215.0f);
 
   if (bpmem.UseEarlyDepthTest() && g_ActiveConfig.bZComploc)
   {
@@ -94,7 +166,9 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  Tev& tev = context.tev;
+  const RasterBlock& rasterBlock = context.rasterBlock;
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -105,7 +179,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(dx, dy);
+      u16 color = (u16)tri.ColorSlopes[i][comp].GetValue(dx, dy);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -134,19 +208,36 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     tev.TextureLinear[i] = rasterBlock.TextureLinear[i];
   }
 
-  tev.Draw();
+  context.tev_pixels_in++;
+  if (!tev.Draw())
+    return;
+  context.tev_pixels_out++;
+
+  if (!context.bbox_updated)
+  {
+    context.bbox_updated = true;
+    context.bbox_left = context.bbox_right = static_cast<u16>(x);
+    context.bbox_top = context.bbox_bottom = static_cast<u16>(y);
+  }
+  else
+  {
+    context.bbox_left = std::min(context.bbox_left, static_cast<u16>(x));
+    context.bbox_right = std::max(context.bbox_right, static_cast<u16>(x));
+    context.bbox_top = std::min(context.bbox_top, static_cast<u16>(y));
+    context.bbox_bottom = std::max(context.bbox_bottom, static_cast<u16>(y));
+  }
 }
 
-static void InitTriangle(float X1, float Y1, s32 xi, s32 yi)
+static void InitTriangle(TriangleSetup* tri, float X1, float Y1, s32 xi, s32 yi)
 {
-  vertex0X = xi;
-  vertex0Y = yi;
+  tri->vertex0X = xi;
+  tri->vertex0Y = yi;
 
   // adjust a little less than 0.5
   const float adjust = 0.495f;
 
-  vertexOffsetX = ((float)xi - X1) + adjust;
-  vertexOffsetY = ((float)yi - Y1) + adjust;
+  tri->vertexOffsetX = ((float)xi - X1) + adjust;
+  tri->vertexOffsetY = ((float)yi - Y1) + adjust;
 }
 
 static void InitSlope(Slope* slope, float f1, float f2, float f3, float DX31, float DX12,
@@ -162,7 +253,8 @@ static void InitSlope(Slope* slope, float f1, float f2, float f3, float DX31, fl
   slope->f0 = f1;
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   const FourTexUnits& texUnit = bpmem.tex[(texmap >> 2) & 1];
   const u8 subTexmap = texmap & 3;
@@ -175,17 +267,17 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   float sDelta, tDelta;
   if (tm0.diag_lod)
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
 
     sDelta = fabsf(uv0[0] - uv1[0]);
     tDelta = fabsf(uv0[1] - uv1[1]);
   }
   else
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
-    float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
+    const float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
     sDelta = std::max(fabsf(uv0[0] - uv1[0]), fabsf(uv0[0] - uv2[0]));
     tDelta = std::max(fabsf(uv0[1] - uv1[1]), fabsf(uv0[1] - uv2[1]));
@@ -210,30 +302,31 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterContext& context, const TriangleSetup& tri, s32 blockX, s32 blockY)
 {
+  RasterBlock& rasterBlock = context.rasterBlock;
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
     for (s32 xi = 0; xi < BLOCK_SIZE; xi++)
     {
       RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
-      float dx = vertexOffsetX + (float)(xi + blockX - vertex0X);
-      float dy = vertexOffsetY + (float)(yi + blockY - vertex0Y);
+      float dx = tri.vertexOffsetX + (float)(xi + blockX - tri.vertex0X);
+      float dy = tri.vertexOffsetY + (float)(yi + blockY - tri.vertex0Y);
 
-      float invW = 1.0f / WSlope.GetValue(dx, dy);
+      float invW = 1.0f / tri.WSlope.GetValue(dx, dy);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(dx, dy) * invW;
+        float q = tri.TexSlopes[i][2].GetValue(dx, dy) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(dx, dy) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(dx, dy) * projection;
+        pixel.Uv[i][0] = tri.TexSlopes[i][0].GetValue(dx, dy) * projection;
+        pixel.Uv[i][1] = tri.TexSlopes[i][1].GetValue(dx, dy) * projection;
       }
     }
   }
@@ -246,7 +339,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texcoord = indref & 3;
     indref >>= 3;
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -258,7 +352,118 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
+    }
+  }
+}
+
+// Rasterizes the blocks of a triangle which start within [x_begin, x_end) x [y_begin, y_end).
+static void RasterizeTriangle(RasterContext& context, const TriangleSetup& tri, s32 x_begin,
+                              s32 x_end, s32 y_begin, s32 y_end)
+{
+  const s32 C1 = tri.C1;
+  const s32 C2 = tri.C2;
+  const s32 C3 = tri.C3;
+
+  const s32 DX12 = tri.DX12;
+  const s32 DX23 = tri.DX23;
+  const s32 DX31 = tri.DX31;
+
+  const s32 DY12 = tri.DY12;
+  const s32 DY23 = tri.DY23;
+  const s32 DY31 = tri.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
+  const s32 minx = std::max(tri.minx, x_begin);
+  const s32 maxx = std::min(tri.maxx, x_end);
+  const s32 miny = std::max(tri.miny, y_begin);
+  const s32 maxy = std::min(tri.maxy, y_end);
+
+  // Loop through blocks
+  for (s32 y = miny; y < maxy; y += BLOCK_SIZE)
+  {
+    for (s32 x = minx; x < maxx; x += BLOCK_SIZE)
+    {
+      // Corners of block
+      s32 x0 = x << 4;
+      s32 x1 = (x + BLOCK_SIZE - 1) << 4;
+      s32 y0 = y << 4;
+      s32 y1 = (y + BLOCK_SIZE - 1) << 4;
+
+      // Evaluate half-space functions
+      bool a00 = C1 + DX12 * y0 - DY12 * x0 > 0;
+      bool a10 = C1 + DX12 * y0 - DY12 * x1 > 0;
+      bool a01 = C1 + DX12 * y1 - DY12 * x0 > 0;
+      bool a11 = C1 + DX12 * y1 - DY12 * x1 > 0;
+      int a = (a00 << 0) | (a10 << 1) | (a01 << 2) | (a11 << 3);
+
+      bool b00 = C2 + DX23 * y0 - DY23 * x0 > 0;
+      bool b10 = C2 + DX23 * y0 - DY23 * x1 > 0;
+      bool b01 = C2 + DX23 * y1 - DY23 * x0 > 0;
+      bool b11 = C2 + DX23 * y1 - DY23 * x1 > 0;
+      int b = (b00 << 0) | (b10 << 1) | (b01 << 2) | (b11 << 3);
+
+      bool c00 = C3 + DX31 * y0 - DY31 * x0 > 0;
+      bool c10 = C3 + DX31 * y0 - DY31 * x1 > 0;
+      bool c01 = C3 + DX31 * y1 - DY31 * x0 > 0;
+      bool c11 = C3 + DX31 * y1 - DY31 * x1 > 0;
+      int c = (c00 << 0) | (c10 << 1) | (c01 << 2) | (c11 << 3);
+
+      // Skip block when outside an edge
+      if (a == 0x0 || b == 0x0 || c == 0x0)
+        continue;
+
+      BuildBlock(context, tri, x, y);
+
+      // Accept whole block when totally covered
+      if (a == 0xF && b == 0xF && c == 0xF)
+      {
+        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
+        {
+          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
+          {
+            Draw(context, tri, x + ix, y + iy, ix, iy);
+          }
+        }
+      }
+      else  // Partially covered block
+      {
+        s32 CY1 = C1 + DX12 * y0 - DY12 * x0;
+        s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
+        s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
+
+        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
+        {
+          s32 CX1 = CY1;
+          s32 CX2 = CY2;
+          s32 CX3 = CY3;
+
+          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
+          {
+            if (CX1 > 0 && CX2 > 0 && CX3 > 0)
+            {
+              Draw(context, tri, x + ix, y + iy, ix, iy);
+            }
+
+            CX1 -= FDY12;
+            CX2 -= FDY23;
+            CX3 -= FDY31;
+          }
+
+          CY1 += FDX12;
+          CY2 += FDX23;
+          CY3 += FDX31;
+        }
+      }
     }
   }
 }
@@ -289,15 +494,6 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -340,11 +536,12 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   float fltdy12 = flty1 - v1->screenPosition.y;
   float fltdy31 = v2->screenPosition.y - flty1;
 
-  InitTriangle(fltx1, flty1, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4);
+  TriangleSetup tri;
+  InitTriangle(&tri, fltx1, flty1, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4);
 
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  InitSlope(&WSlope, w[0], w[1], w[2], fltdx31, fltdx12, fltdy12, fltdy31);
+  InitSlope(&tri.WSlope, w[0], w[1], w[2], fltdx31, fltdx12, fltdy12, fltdy31);
 
   // TODO: The zfreeze emulation is not quite correct, yet!
   // Many things might prevent us from reaching this line (culling, clipping, scissoring).
@@ -355,115 +552,223 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   if (!bpmem.genMode.zfreeze || !g_ActiveConfig.bZFreeze)
     InitSlope(&ZSlope, v0->screenPosition[2], v1->screenPosition[2], v2->screenPosition[2], fltdx31,
               fltdx12, fltdy12, fltdy31);
+  tri.ZSlope = ZSlope;
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      InitSlope(&ColorSlopes[i][comp], v0->color[i][comp], v1->color[i][comp], v2->color[i][comp],
-                fltdx31, fltdx12, fltdy12, fltdy31);
+    {
+      InitSlope(&tri.ColorSlopes[i][comp], v0->color[i][comp], v1->color[i][comp],
+                v2->color[i][comp], fltdx31, fltdx12, fltdy12, fltdy31);
+    }
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
-      InitSlope(&TexSlopes[i][comp], v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                v2->texCoords[i][comp] * w[2], fltdx31, fltdx12, fltdy12, fltdy31);
+      InitSlope(&tri.TexSlopes[i][comp], v0->texCoords[i][comp] * w[0],
+                v1->texCoords[i][comp] * w[1], v2->texCoords[i][comp] * w[2], fltdx31, fltdx12,
+                fltdy12, fltdy31);
   }
 
   // Half-edge constants
-  s32 C1 = DY12 * X1 - DX12 * Y1;
-  s32 C2 = DY23 * X2 - DX23 * Y2;
-  s32 C3 = DY31 * X3 - DX31 * Y3;
+  tri.C1 = DY12 * X1 - DX12 * Y1;
+  tri.C2 = DY23 * X2 - DX23 * Y2;
+  tri.C3 = DY31 * X3 - DX31 * Y3;
 
   // Correct for fill convention
   if (DY12 < 0 || (DY12 == 0 && DX12 > 0))
-    C1++;
+    tri.C1++;
   if (DY23 < 0 || (DY23 == 0 && DX23 > 0))
-    C2++;
+    tri.C2++;
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
-    C3++;
+    tri.C3++;
+
+  tri.DX12 = DX12;
+  tri.DX23 = DX23;
+  tri.DX31 = DX31;
+  tri.DY12 = DY12;
+  tri.DY23 = DY23;
+  tri.DY31 = DY31;
 
   // Start in corner of 8x8 block
-  minx &= ~(BLOCK_SIZE - 1);
-  miny &= ~(BLOCK_SIZE - 1);
+  tri.minx = minx & ~(BLOCK_SIZE - 1);
+  tri.miny = miny & ~(BLOCK_SIZE - 1);
+  tri.maxx = maxx;
+  tri.maxy = maxy;
 
-  // Loop through blocks
-  for (s32 y = miny; y < maxy; y += BLOCK_SIZE)
+  if (s_workers.empty())
   {
-    for (s32 x = minx; x < maxx; x += BLOCK_SIZE)
+    RasterizeTriangle(*s_contexts[0], tri, 0, EFB_WIDTH, 0, EFB_HEIGHT);
+    return;
+  }
+
+  const u32 index = static_cast<u32>(s_triangles.size());
+  s_triangles.push_back(tri);
+  for (s32 tile_y = tri.miny / TILE_SIZE; tile_y <= (tri.maxy - 1) / TILE_SIZE; tile_y++)
+  {
+    for (s32 tile_x = tri.minx / TILE_SIZE; tile_x <= (tri.maxx - 1) / TILE_SIZE; tile_x++)
+      s_tile_bins[tile_y * TILES_X + tile_x].push_back(index);
+  }
+}
+
+static void ShadeTiles(RasterContext& context)
+{
+  while (true)
+  {
+    const u32 tile = s_next_tile.fetch_add(1, std::memory_order_relaxed);
+    if (tile >= s_tile_bins.size())
+      break;
+
+    const s32 x_begin = static_cast<s32>(tile % TILES_X) * TILE_SIZE;
+    const s32 y_begin = static_cast<s32>(tile / TILES_X) * TILE_SIZE;
+    for (u32 index : s_tile_bins[tile])
     {
-      // Corners of block
-      s32 x0 = x << 4;
-      s32 x1 = (x + BLOCK_SIZE - 1) << 4;
-      s32 y0 = y << 4;
-      s32 y1 = (y + BLOCK_SIZE - 1) << 4;
+      RasterizeTriangle(context, s_triangles[index], x_begin, x_begin + TILE_SIZE, y_begin,
+                        y_begin + TILE_SIZE);
+    }
+  }
+}
 
-      // Evaluate half-space functions
-      bool a00 = C1 + DX12 * y0 - DY12 * x0 > 0;
-      bool a10 = C1 + DX12 * y0 - DY12 * x1 > 0;
-      bool a01 = C1 + DX12 * y1 - DY12 * x0 > 0;
-      bool a11 = C1 + DX12 * y1 - DY12 * x1 > 0;
-      int a = (a00 << 0) | (a10 << 1) | (a01 << 2) | (a11 << 3);
+static void WorkerThread(RasterContext* context, u64 generation)
+{
+  Common::SetCurrentThreadName("SW Rasterizer");
 
-      bool b00 = C2 + DX23 * y0 - DY23 * x0 > 0;
-      bool b10 = C2 + DX23 * y0 - DY23 * x1 > 0;
-      bool b01 = C2 + DX23 * y1 - DY23 * x0 > 0;
-      bool b11 = C2 + DX23 * y1 - DY23 * x1 > 0;
-      int b = (b00 << 0) | (b10 << 1) | (b01 << 2) | (b11 << 3);
+  std::unique_lock lock(s_workers_mutex);
+  while (true)
+  {
+    s_work_available.wait(lock, [&] { return s_workers_exit || s_work_generation != generation; });
+    if (s_workers_exit)
+      return;
+    generation = s_work_generation;
+
+    lock.unlock();
+    s_work(*context);
+    EfbInterface::FlushPerfCounters();
+    lock.lock();
+
+    if (--s_busy_workers == 0)
+      s_work_done.notify_one();
+  }
+}
 
-      bool c00 = C3 + DX31 * y0 - DY31 * x0 > 0;
-      bool c10 = C3 + DX31 * y0 - DY31 * x1 > 0;
-      bool c01 = C3 + DX31 * y1 - DY31 * x0 > 0;
-      bool c11 = C3 + DX31 * y1 - DY31 * x1 > 0;
-      int c = (c00 << 0) | (c10 << 1) | (c01 << 2) | (c11 << 3);
+// Includes the GPU thread, which shades tiles as well.
+static u32 GetThreadCount()
+{
+  // The TEV debug dumps aren't thread-safe.
+  if (g_ActiveConfig.bDumpTevStages || g_ActiveConfig.bDumpTevTextureFetches)
+    return 1;
 
-      // Skip block when outside an edge
-      if (a == 0x0 || b == 0x0 || c == 0x0)
-        continue;
+  return g_ActiveConfig.GetSWRasterizerThreads();
+}
 
-      BuildBlock(x, y);
+static void StartWorkers(u32 num_threads)
+{
+  CreateContexts(num_threads);
 
-      // Accept whole block when totally covered
-      if (a == 0xF && b == 0xF && c == 0xF)
-      {
-        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
-        {
-          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
-          {
-            Draw(x + ix, y + iy, ix, iy);
-          }
-        }
-      }
-      else  // Partially covered block
-      {
-        s32 CY1 = C1 + DX12 * y0 - DY12 * x0;
-        s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
-        s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
+  s_workers_exit = false;
+  for (u32 i = 1; i < num_threads; i++)
+    s_workers.emplace_back(WorkerThread, s_contexts[i].get(), s_work_generation);
+}
 
-        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
-        {
-          s32 CX1 = CY1;
-          s32 CX2 = CY2;
-          s32 CX3 = CY3;
+static void StopWorkers()
+{
+  {
+    std::lock_guard lock(s_workers_mutex);
+    s_workers_exit = true;
+  }
+  s_work_available.notify_all();
 
-          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
-          {
-            if (CX1 > 0 && CX2 > 0 && CX3 > 0)
-            {
-              Draw(x + ix, y + iy, ix, iy);
-            }
+  for (std::thread& worker : s_workers)
+    worker.join();
+  s_workers.clear();
+}
 
-            CX1 -= FDY12;
-            CX2 -= FDY23;
-            CX3 -= FDY31;
-          }
+// Runs work on every thread, and returns once all of them are done.
+static void Dispatch(std::function<void(RasterContext&)> work)
+{
+  s_work = std::move(work);
+  {
+    std::lock_guard lock(s_workers_mutex);
+    s_busy_workers = static_cast<u32>(s_workers.size());
+    s_work_generation++;
+  }
+  s_work_available.notify_all();
 
-          CY1 += FDX12;
-          CY2 += FDX23;
-          CY3 += FDX31;
-        }
-      }
+  s_work(*s_contexts[0]);
+
+  {
+    std::unique_lock lock(s_workers_mutex);
+    s_work_done.wait(lock, [] { return s_busy_workers == 0; });
+  }
+  s_work = {};
+}
+
+void RunOnAllThreads(const std::function<void(u32 index, u32 count)>& func)
+{
+  const u32 count = static_cast<u32>(s_workers.size() + 1);
+  if (count == 1)
+  {
+    func(0, 1);
+    return;
+  }
+
+  Dispatch([&](RasterContext& context) { func(context.index, count); });
+}
+
+void Init()
+{
+  StartWorkers(GetThreadCount());
+
+  // Set initial z reference plane in the unlikely case that zfreeze is enabled when drawing the
+  // first primitive.
+  // TODO: This is just a guess!
+  ZSlope.dfdx = ZSlope.dfdy = 0.f;
+  ZSlope.f0 = 1.f;
+}
+
+void Shutdown()
+{
+  StopWorkers();
+  s_contexts.clear();
+}
+
+void Flush()
+{
+  if (!s_triangles.empty())
+  {
+    s_next_tile.store(0, std::memory_order_relaxed);
+    Dispatch(ShadeTiles);
+
+    s_triangles.clear();
+    for (std::vector<u32>& bin : s_tile_bins)
+      bin.clear();
+  }
+  EfbInterface::FlushPerfCounters();
+
+  for (auto& context : s_contexts)
+  {
+    ADDSTAT(g_stats.this_frame.rasterized_pixels, context->rasterized_pixels);
+    ADDSTAT(g_stats.this_frame.tev_pixels_in, context->tev_pixels_in);
+    ADDSTAT(g_stats.this_frame.tev_pixels_out, context->tev_pixels_out);
+    context->rasterized_pixels = 0;
+    context->tev_pixels_in = 0;
+    context->tev_pixels_out = 0;
+
+    if (context->bbox_updated)
+    {
+      BoundingBox::Update(context->bbox_left, context->bbox_right, context->bbox_top,
+                          context->bbox_bottom);
+      context->bbox_updated = false;
     }
   }
+
+  // Apply changes of the thread count between batches.
+  const u32 num_threads = GetThreadCount();
+  if (num_threads != s_workers.size() + 1)
+  {
+    StopWorkers();
+    StartWorkers(num_threads);
+  }
 }
 }  // namespace Rasterizer
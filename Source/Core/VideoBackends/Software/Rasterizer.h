@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "Common/CommonTypes.h"
 
 struct OutputVertexData;
@@ -11,9 +13,18 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 
+// Triangles may be binned and shaded later on multiple threads. Flush must be called before any
+// state used for shading changes, and before the EFB is accessed in any other way.
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
+void Flush();
+
+// Calls func once on each of the rasterizer threads, including the calling thread, and waits for
+// all of them to return. count is the number of threads, index is unique to each call.
+// Must only be used while no triangles are pending, i.e. outside of batches.
+void RunOnAllThreads(const std::function<void(u32 index, u32 count)>& func);
 
 void SetTevReg(int reg, int comp, s16 color);
 
@@ -92,6 +92,9 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
     INCSTAT(g_stats.this_frame.num_vertices_loaded)
   }
 
+  // All state is constant within a batch, so shading the whole batch at once is safe.
+  Rasterizer::Flush();
+
   DebugUtil::OnObjectEnd();
 }
 
@@ -85,7 +85,9 @@ public:
 
   void Init();
 
-  void Draw();
+  // Returns whether the pixel passed the alpha and depth tests and was written to the EFB. The
+  // caller is responsible for the pixel statistics and the bounding box.
+  bool Draw();
 
   void SetRegColor(int reg, int comp, s16 color);
 };
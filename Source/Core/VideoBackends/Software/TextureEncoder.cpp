@@ -4,14 +4,19 @@
 
 #include "VideoBackends/Software/TextureEncoder.h"
 
+#include <cstring>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
+#include "VideoBackends/Software/Rasterizer.h"
 #include "VideoBackends/Software/SWTexture.h"
 
 #include "VideoCommon/BPMemory.h"
@@ -235,10 +240,21 @@ static void SetSpans(int sBlkSize, int tBlkSize, s32* tSpan, s32* sBlkSpan, s32*
   *writeStride = bpmem.copyMipMapStrideChannels * 32;
 }
 
+// Returns the number of bytes between the first texels of two consecutive rows of blocks, i.e. the
+// distance the src pointer advances by over one row of blocks.
+static s32 GetBlockRowSpan(u16 sBlkCount, u16 tBlkSize, u32 readStride, s32 sBlkSpan, s32 tBlkSpan)
+{
+  const s32 blockSpan = tBlkSize * 640 * static_cast<s32>(readStride) + sBlkSpan;
+  return sBlkCount * blockSpan + tBlkSpan;
+}
+
+// Only every tBlkStep-th row of blocks is encoded, starting at tBlkFirst, so that a copy can be
+// split across threads.
 #define ENCODE_LOOP_BLOCKS                                                                         \
-  for (int tBlk = 0; tBlk < tBlkCount; tBlk++)                                                     \
+  for (int tBlk = tBlkFirst; tBlk < tBlkCount; tBlk += tBlkStep)                                   \
   {                                                                                                \
-    dst = dstBlockStart;                                                                           \
+    src = srcStart + tBlk * GetBlockRowSpan(sBlkCount, tBlkSize, readStride, sBlkSpan, tBlkSpan);  \
+    dst = dstBlockStart + tBlk * writeStride;                                                      \
     for (int sBlk = 0; sBlk < sBlkCount; sBlk++)                                                   \
     {                                                                                              \
       for (int t = 0; t < tBlkSize; t++)                                                           \
@@ -251,8 +267,6 @@ static void SetSpans(int sBlkSize, int tBlkSize, s32* tSpan, s32* sBlkSpan, s32*
   }                                                                                                \
   src += sBlkSpan;                                                                                 \
   }                                                                                                \
-  src += tBlkSpan;                                                                                 \
-  dstBlockStart += writeStride;                                                                    \
   }
 
 #define ENCODE_LOOP_SPANS2                                                                         \
@@ -262,17 +276,17 @@ static void SetSpans(int sBlkSize, int tBlkSize, s32* tSpan, s32* sBlkSpan, s32*
   src += sBlkSpan;                                                                                 \
   dst += 32;                                                                                       \
   }                                                                                                \
-  src += tBlkSpan;                                                                                 \
-  dstBlockStart += writeStride;                                                                    \
   }
 
-static void EncodeRGBA6(u8* dst, const u8* src, EFBCopyFormat format, bool yuv)
+static void EncodeRGBA6(u8* dst, const u8* src, EFBCopyFormat format, bool yuv, int tBlkFirst,
+                        int tBlkStep)
 {
   u16 sBlkCount, tBlkCount, sBlkSize, tBlkSize;
   s32 tSpan, sBlkSpan, tBlkSpan, writeStride;
   u8 r, g, b, a;
   u32 readStride = 3;
-  u8* dstBlockStart = dst;
+  const u8* const srcStart = src;
+  u8* const dstBlockStart = dst;
 
   switch (format)
   {
@@ -509,13 +523,15 @@ static void EncodeRGBA6(u8* dst, const u8* src, EFBCopyFormat format, bool yuv)
   }
 }
 
-static void EncodeRGBA6halfscale(u8* dst, const u8* src, EFBCopyFormat format, bool yuv)
+static void EncodeRGBA6halfscale(u8* dst, const u8* src, EFBCopyFormat format, bool yuv,
+                                 int tBlkFirst, int tBlkStep)
 {
   u16 sBlkCount, tBlkCount, sBlkSize, tBlkSize;
   s32 tSpan, sBlkSpan, tBlkSpan, writeStride;
   u8 r, g, b, a;
   u32 readStride = 6;
-  u8* dstBlockStart = dst;
+  const u8* const srcStart = src;
+  u8* const dstBlockStart = dst;
 
   switch (format)
   {
@@ -748,12 +764,14 @@ static void EncodeRGBA6halfscale(u8* dst, const u8* src, EFBCopyFormat format, b
   }
 }
 
-static void EncodeRGB8(u8* dst, const u8* src, EFBCopyFormat format, bool yuv)
+static void EncodeRGB8(u8* dst, const u8* src, EFBCopyFormat format, bool yuv, int tBlkFirst,
+                       int tBlkStep)
 {
   u16 sBlkCount, tBlkCount, sBlkSize, tBlkSize;
   s32 tSpan, sBlkSpan, tBlkSpan, writeStride;
   u32 readStride = 3;
-  u8* dstBlockStart = dst;
+  const u8* const srcStart = src;
+  u8* const dstBlockStart = dst;
 
   switch (format)
   {
@@ -965,13 +983,15 @@ static void EncodeRGB8(u8* dst, const u8* src, EFBCopyFormat format, bool yuv)
   }
 }
 
-static void EncodeRGB8halfscale(u8* dst, const u8* src, EFBCopyFormat format, bool yuv)
+static void EncodeRGB8halfscale(u8* dst, const u8* src, EFBCopyFormat format, bool yuv,
+                                int tBlkFirst, int tBlkStep)
 {
   u16 sBlkCount, tBlkCount, sBlkSize, tBlkSize;
   s32 tSpan, sBlkSpan, tBlkSpan, writeStride;
   u8 r, g, b;
   u32 readStride = 6;
-  u8* dstBlockStart = dst;
+  const u8* const srcStart = src;
+  u8* const dstBlockStart = dst;
 
   switch (format)
   {
@@ -1197,12 +1217,13 @@ static void EncodeRGB8halfscale(u8* dst, const u8* src, EFBCopyFormat format, bo
   }
 }
 
-static void EncodeZ24(u8* dst, const u8* src, EFBCopyFormat format)
+static void EncodeZ24(u8* dst, const u8* src, EFBCopyFormat format, int tBlkFirst, int tBlkStep)
 {
   u16 sBlkCount, tBlkCount, sBlkSize, tBlkSize;
   s32 tSpan, sBlkSpan, tBlkSpan, writeStride;
   u32 readStride = 3;
-  u8* dstBlockStart = dst;
+  const u8* const srcStart = src;
+  u8* const dstBlockStart = dst;
 
   switch (format)
   {
@@ -1305,13 +1326,15 @@ static void EncodeZ24(u8* dst, const u8* src, EFBCopyFormat format)
   }
 }
 
-static void EncodeZ24halfscale(u8* dst, const u8* src, EFBCopyFormat format)
+static void EncodeZ24halfscale(u8* dst, const u8* src, EFBCopyFormat format, int tBlkFirst,
+                               int tBlkStep)
 {
   u16 sBlkCount, tBlkCount, sBlkSize, tBlkSize;
   s32 tSpan, sBlkSpan, tBlkSpan, writeStride;
   u32 readStride = 6;
   u8 r, g, b;
-  u8* dstBlockStart = dst;
+  const u8* const srcStart = src;
+  u8* const dstBlockStart = dst;
 
   switch (format)
   {
@@ -1419,29 +1442,212 @@ static void EncodeZ24halfscale(u8* dst, const u8* src, EFBCopyFormat format)
   }
 }
 
-namespace
+#ifdef _M_X86
+// Fast paths for the most common copy formats, which encode a whole row of a block (4 or 8 texels)
+// at once. They produce exactly the same output as the corresponding cases in EncodeRGB8 and
+// EncodeZ24.
+
+// Loads 4 pixels (12 bytes) into the low 12 bytes, without reading past them.
+static inline __m128i Load4Pixels(const u8* src)
 {
-void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, u32 native_width, u32 bytes_per_row,
-                   u32 num_blocks_y, u32 memory_stride, const MathUtil::Rectangle<int>& src_rect,
-                   bool scale_by_half)
+  u32 last;
+  std::memcpy(&last, src + 8, sizeof(u32));
+  return _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)),
+                            _mm_cvtsi32_si128(last));
+}
+
+// Computes RGB8_to_I for 4 pixels, the results are in the low byte of each 32-bit lane.
+FUNCTION_TARGET_SSSE3
+static inline __m128i RGB8_to_I_SSSE3(__m128i pixels)
 {
-  const u8* src = EfbInterface::GetPixelPointer(src_rect.left, src_rect.top, params.depth);
+  // Each pixel is expanded to the 16-bit values (b, g, r, 0), so that a multiply-add and a
+  // horizontal add compute 25 * b + 129 * g + 66 * r.
+  const __m128i expand01 = _mm_setr_epi8(0, -1, 1, -1, 2, -1, -1, -1, 3, -1, 4, -1, 5, -1, -1, -1);
+  const __m128i expand23 =
+      _mm_setr_epi8(6, -1, 7, -1, 8, -1, -1, -1, 9, -1, 10, -1, 11, -1, -1, -1);
+  const __m128i weights = _mm_setr_epi16(25, 129, 66, 0, 25, 129, 66, 0);
+
+  const __m128i sum01 = _mm_madd_epi16(_mm_shuffle_epi8(pixels, expand01), weights);
+  const __m128i sum23 = _mm_madd_epi16(_mm_shuffle_epi8(pixels, expand23), weights);
+  const __m128i sum = _mm_add_epi32(_mm_hadd_epi32(sum01, sum23), _mm_set1_epi32(4096));
+  return _mm_srli_epi32(sum, 8);
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGB565_SSSE3(u8* dst, const u8* src)
+{
+  const __m128i pixels = _mm_shuffle_epi8(
+      Load4Pixels(src), _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+
+  const __m128i r = _mm_and_si128(_mm_srli_epi32(pixels, 8), _mm_set1_epi32(0xf800));
+  const __m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 5), _mm_set1_epi32(0x07e0));
+  const __m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 3), _mm_set1_epi32(0x001f));
+  const __m128i rgb565 = _mm_or_si128(_mm_or_si128(r, g), b);
+
+  // Stored big endian.
+  const __m128i swapped = _mm_shuffle_epi8(
+      rgb565, _mm_setr_epi8(1, 0, 5, 4, 9, 8, 13, 12, -1, -1, -1, -1, -1, -1, -1, -1));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), swapped);
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGBA8_SSSE3(u8* dst, const u8* src)
+{
+  // AR pairs go to the first half of the block, GB pairs to the second half.
+  const __m128i argb = _mm_or_si128(
+      _mm_shuffle_epi8(Load4Pixels(src),
+                       _mm_setr_epi8(-1, 2, -1, 5, -1, 8, -1, 11, 1, 0, 4, 3, 7, 6, 10, 9)),
+      _mm_setr_epi8(-1, 0, -1, 0, -1, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), argb);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 32), _mm_unpackhi_epi64(argb, argb));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowR8_SSSE3(u8* dst, const u8* src)
+{
+  const __m128i red0 = _mm_shuffle_epi8(
+      Load4Pixels(src), _mm_setr_epi8(2, 5, 8, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+  const __m128i red1 = _mm_shuffle_epi8(
+      Load4Pixels(src + 12),
+      _mm_setr_epi8(-1, -1, -1, -1, 2, 5, 8, 11, -1, -1, -1, -1, -1, -1, -1, -1));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_or_si128(red0, red1));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowI8_SSSE3(u8* dst, const u8* src)
+{
+  const __m128i i0 = RGB8_to_I_SSSE3(Load4Pixels(src));
+  const __m128i i1 = RGB8_to_I_SSSE3(Load4Pixels(src + 12));
+  const __m128i i16 = _mm_packs_epi32(i0, i1);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(i16, i16));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRA8_SSSE3(u8* dst, const u8* src)
+{
+  const __m128i ar = _mm_or_si128(
+      _mm_shuffle_epi8(Load4Pixels(src),
+                       _mm_setr_epi8(-1, 2, -1, 5, -1, 8, -1, 11, -1, -1, -1, -1, -1, -1, -1, -1)),
+      _mm_setr_epi8(-1, 0, -1, 0, -1, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), ar);
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowIA8_SSSE3(u8* dst, const u8* src)
+{
+  // Intensity in the high byte of each 16-bit lane, alpha in the low byte.
+  const __m128i i = RGB8_to_I_SSSE3(Load4Pixels(src));
+  const __m128i ai = _mm_or_si128(_mm_slli_epi16(_mm_packs_epi32(i, i), 8), _mm_set1_epi16(0x00ff));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), ai);
+}
+
+// Encodes the rows of blocks like ENCODE_LOOP_BLOCKS, with EncodeRow encoding a row of a block into
+// 8 bytes. blockSize is the distance between two blocks in dst.
+template <void (*EncodeRow)(u8* dst, const u8* src)>
+FUNCTION_TARGET_SSSE3 static void EncodeBlocksSSSE3(u8* dst, const u8* src, int blkWidthLog2,
+                                                    int blkHeightLog2, u32 blockSize,
+                                                    int tBlkFirst, int tBlkStep)
+{
+  u16 sBlkCount, tBlkCount, sBlkSize, tBlkSize;
+  s32 tSpan, sBlkSpan, tBlkSpan, writeStride;
+  SetBlockDimensions(blkWidthLog2, blkHeightLog2, &sBlkCount, &tBlkCount, &sBlkSize, &tBlkSize);
+  SetSpans(sBlkSize, tBlkSize, &tSpan, &sBlkSpan, &tBlkSpan, &writeStride);
+  const s32 blkRowSpan = GetBlockRowSpan(sBlkCount, tBlkSize, 3, sBlkSpan, tBlkSpan);
+
+  for (int tBlk = tBlkFirst; tBlk < tBlkCount; tBlk += tBlkStep)
+  {
+    const u8* blkSrc = src + tBlk * blkRowSpan;
+    u8* blkDst = dst + tBlk * writeStride;
+    for (int sBlk = 0; sBlk < sBlkCount; sBlk++)
+    {
+      for (int t = 0; t < tBlkSize; t++)
+        EncodeRow(blkDst + t * 8, blkSrc + t * 640 * 3);
+
+      blkSrc += sBlkSize * 3;
+      blkDst += blockSize;
+    }
+  }
+}
+
+// Returns false if there is no fast path for the copy.
+static bool EncodeSSSE3(u8* dst, const u8* src, const EFBCopyParams& params, int tBlkFirst,
+                        int tBlkStep)
+{
+  if (params.efb_format == PEControl::RGB8_Z24 || params.efb_format == PEControl::RGB565_Z16)
+  {
+    switch (params.copy_format)
+    {
+    case EFBCopyFormat::RGB565:
+      EncodeBlocksSSSE3<EncodeRowRGB565_SSSE3>(dst, src, 2, 2, 32, tBlkFirst, tBlkStep);
+      return true;
+    case EFBCopyFormat::RGBA8:
+      EncodeBlocksSSSE3<EncodeRowRGBA8_SSSE3>(dst, src, 2, 2, 64, tBlkFirst, tBlkStep);
+      return true;
+    case EFBCopyFormat::R8_0x1:
+    case EFBCopyFormat::R8:
+      if (params.yuv)
+        EncodeBlocksSSSE3<EncodeRowI8_SSSE3>(dst, src, 3, 2, 32, tBlkFirst, tBlkStep);
+      else
+        EncodeBlocksSSSE3<EncodeRowR8_SSSE3>(dst, src, 3, 2, 32, tBlkFirst, tBlkStep);
+      return true;
+    case EFBCopyFormat::RA8:
+      if (params.yuv)
+        EncodeBlocksSSSE3<EncodeRowIA8_SSSE3>(dst, src, 2, 2, 32, tBlkFirst, tBlkStep);
+      else
+        EncodeBlocksSSSE3<EncodeRowRA8_SSSE3>(dst, src, 2, 2, 32, tBlkFirst, tBlkStep);
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  if (params.efb_format == PEControl::Z24)
+  {
+    // The depth is stored like an RGB8 color, with the most significant byte in place of red.
+    switch (params.copy_format)
+    {
+    case EFBCopyFormat::RGBA8:
+      EncodeBlocksSSSE3<EncodeRowRGBA8_SSSE3>(dst, src, 2, 2, 64, tBlkFirst, tBlkStep);
+      return true;
+    case EFBCopyFormat::R8_0x1:
+    case EFBCopyFormat::R8:
+      EncodeBlocksSSSE3<EncodeRowR8_SSSE3>(dst, src, 3, 2, 32, tBlkFirst, tBlkStep);
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  return false;
+}
+#endif
+
+static void EncodeBlockRows(u8* dst, const u8* src, const EFBCopyParams& params,
+                            bool scale_by_half, bool reference, int tBlkFirst, int tBlkStep)
+{
+#ifdef _M_X86
+  if (!reference && !scale_by_half && cpu_info.bSSSE3 &&
+      EncodeSSSE3(dst, src, params, tBlkFirst, tBlkStep))
+  {
+    return;
+  }
+#endif
 
   if (scale_by_half)
   {
     switch (params.efb_format)
     {
     case PEControl::RGBA6_Z24:
-      EncodeRGBA6halfscale(dst, src, params.copy_format, params.yuv);
+      EncodeRGBA6halfscale(dst, src, params.copy_format, params.yuv, tBlkFirst, tBlkStep);
       break;
     case PEControl::RGB8_Z24:
-      EncodeRGB8halfscale(dst, src, params.copy_format, params.yuv);
+      EncodeRGB8halfscale(dst, src, params.copy_format, params.yuv, tBlkFirst, tBlkStep);
       break;
     case PEControl::RGB565_Z16:
-      EncodeRGB8halfscale(dst, src, params.copy_format, params.yuv);
+      EncodeRGB8halfscale(dst, src, params.copy_format, params.yuv, tBlkFirst, tBlkStep);
       break;
     case PEControl::Z24:
-      EncodeZ24halfscale(dst, src, params.copy_format);
+      EncodeZ24halfscale(dst, src, params.copy_format, tBlkFirst, tBlkStep);
       break;
     default:
       break;
@@ -1452,23 +1658,43 @@ void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, u32 native_width, u32 b
     switch (params.efb_format)
     {
     case PEControl::RGBA6_Z24:
-      EncodeRGBA6(dst, src, params.copy_format, params.yuv);
+      EncodeRGBA6(dst, src, params.copy_format, params.yuv, tBlkFirst, tBlkStep);
       break;
     case PEControl::RGB8_Z24:
-      EncodeRGB8(dst, src, params.copy_format, params.yuv);
+      EncodeRGB8(dst, src, params.copy_format, params.yuv, tBlkFirst, tBlkStep);
       break;
     case PEControl::RGB565_Z16:
-      EncodeRGB8(dst, src, params.copy_format, params.yuv);
+      EncodeRGB8(dst, src, params.copy_format, params.yuv, tBlkFirst, tBlkStep);
       break;
     case PEControl::Z24:
-      EncodeZ24(dst, src, params.copy_format);
+      EncodeZ24(dst, src, params.copy_format, tBlkFirst, tBlkStep);
       break;
     default:
       break;
     }
   }
 }
-}  // namespace
+
+void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, const MathUtil::Rectangle<int>& src_rect,
+                   bool scale_by_half, bool reference)
+{
+  const u8* src = EfbInterface::GetPixelPointer(src_rect.left, src_rect.top, params.depth);
+
+  // Small copies aren't worth waking up the other threads for. Rows of blocks are distributed
+  // round-robin, so that every thread gets a similar share of the copy.
+  constexpr u32 MIN_LINES_FOR_THREADING = 64;
+  const u32 lines = (bpmem.copyTexSrcWH.y + 1) >> bpmem.triggerEFBCopy.half_scale;
+  if (reference || lines < MIN_LINES_FOR_THREADING)
+  {
+    EncodeBlockRows(dst, src, params, scale_by_half, reference, 0, 1);
+    return;
+  }
+
+  Rasterizer::RunOnAllThreads([&](u32 index, u32 count) {
+    EncodeBlockRows(dst, src, params, scale_by_half, false, static_cast<int>(index),
+                    static_cast<int>(count));
+  });
+}
 
 void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native_width,
             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
@@ -1489,8 +1715,8 @@ void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native
   }
   else
   {
-    EncodeEfbCopy(reinterpret_cast<u8*>(dst->GetMappedPointer()), params, native_width,
-                  bytes_per_row, num_blocks_y, memory_stride, src_rect, scale_by_half);
+    EncodeEfbCopy(reinterpret_cast<u8*>(dst->GetMappedPointer()), params, src_rect,
+                  scale_by_half);
   }
 }
 }  // namespace TextureEncoder
@@ -14,4 +14,10 @@ void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native
             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
             const MathUtil::Rectangle<int>& src_rect, bool scale_by_half, float y_scale,
             float gamma);
-}
+
+// Encodes the EFB copy described by bpmem and params into dst, laid out like in guest memory.
+// Large copies are split across the rasterizer threads. If reference is set, the copy is encoded on
+// the calling thread using only the scalar encoders, which the faster paths are tested against.
+void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, const MathUtil::Rectangle<int>& src_rect,
+                   bool scale_by_half, bool reference = false);
+}  // namespace TextureEncoder
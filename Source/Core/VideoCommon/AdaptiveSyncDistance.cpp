@@ -0,0 +1,54 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/AdaptiveSyncDistance.h"
+
+#include <algorithm>
+
+namespace Fifo
+{
+void AdaptiveSyncDistance::Reset(int distance)
+{
+  m_distance = distance;
+  m_window_ticks = 0;
+  m_stalls = 0;
+  m_stall_us = 0;
+  m_calm_windows = 0;
+}
+
+void AdaptiveSyncDistance::AddStall(u64 stall_us)
+{
+  m_stalls++;
+  m_stall_us += stall_us;
+}
+
+void AdaptiveSyncDistance::Update(int ticks, int window_size, int lower, int upper, int step)
+{
+  m_window_ticks += ticks;
+  if (m_window_ticks < window_size)
+    return;
+
+  if (m_stalls == 0)
+  {
+    m_calm_windows++;
+    if (m_calm_windows >= CALM_WINDOWS_TO_SHRINK)
+    {
+      m_distance -= m_distance / 16;
+      m_calm_windows = 0;
+    }
+  }
+  else
+  {
+    m_calm_windows = 0;
+    if (m_stalls >= MIN_STALLS_TO_GROW && m_stall_us < m_stalls * SHORT_STALL_US)
+      m_distance += m_distance / 4 + step;
+  }
+
+  m_distance = std::clamp(m_distance, lower, upper);
+
+  m_window_ticks = 0;
+  m_stalls = 0;
+  m_stall_us = 0;
+}
+}  // namespace Fifo
@@ -0,0 +1,50 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace Fifo
+{
+// Tunes the distance at which the CPU thread blocks until the GPU thread has caught up in SyncGPU
+// mode, once per window of emulated time.
+//
+// When the CPU thread didn't have to wait for a while, the distance is tightened a little to
+// reduce the lag between CPU and GPU. When it waited often but only briefly, most of the time went
+// into the wakeup handshake, so the distance is loosened to make the waits rarer. Long stalls mean
+// that the GPU thread is simply slower, which a larger distance can't fix, so the distance is
+// kept. Growing quickly but only shrinking slowly after several calm windows keeps the distance
+// from swinging back and forth.
+class AdaptiveSyncDistance
+{
+public:
+  // Stalls shorter than this are mostly the cost of the wakeup handshake itself.
+  static constexpr u64 SHORT_STALL_US = 50;
+  // A window needs at least this many short stalls for the distance to be loosened.
+  static constexpr int MIN_STALLS_TO_GROW = 3;
+  // The distance is only tightened after this many consecutive windows without any stalls.
+  static constexpr int CALM_WINDOWS_TO_SHRINK = 4;
+
+  explicit AdaptiveSyncDistance(int distance = 0) { Reset(distance); }
+
+  void Reset(int distance);
+
+  // Records a stall of the CPU thread in the current window.
+  void AddStall(u64 stall_us);
+
+  // Accounts for <ticks> of emulated time. Once the current window is window_size ticks long, the
+  // distance is reevaluated and clamped to [lower, upper], and a new window starts.
+  void Update(int ticks, int window_size, int lower, int upper, int step);
+
+  int GetDistance() const { return m_distance; }
+
+private:
+  int m_distance;
+  int m_window_ticks;
+  int m_stalls;
+  u64 m_stall_us;
+  int m_calm_windows;
+};
+}  // namespace Fifo
@@ -2,9 +2,11 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
 #include <mutex>
 
 #include "VideoCommon/AsyncRequests.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/Statistics.h"
@@ -158,6 +160,18 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
     *e.bbox.data = g_renderer->BBoxRead(e.bbox.index);
     break;
 
+  case Event::BBOX_READBACK:
+  {
+    std::array<u16, 4> coordinates;
+    if (g_renderer->BBoxPollReadback(&coordinates))
+    {
+      INCSTAT(g_stats.this_frame.num_bbox_readbacks);
+      BoundingBox::SetReadbackCoordinates(coordinates);
+    }
+    g_renderer->BBoxRequestReadback();
+    break;
+  }
+
   case Event::PERF_QUERY:
     g_perf_query->FlushResults();
     break;
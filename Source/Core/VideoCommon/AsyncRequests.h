@@ -28,6 +28,7 @@ public:
       EFB_PEEK_Z,
       SWAP_EVENT,
       BBOX_READ,
+      BBOX_READBACK,
       PERF_QUERY,
       DO_SAVE_STATE,
     } type;
@@ -10,6 +10,7 @@
 
 #include <fmt/format.h>
 
+#include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -32,6 +33,7 @@
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
@@ -47,6 +49,77 @@ void BPInit()
   bpmem.bpMask = 0xFFFFFF;
 }
 
+// Returns the texture maps sampled by the active TEV and indirect stages, as loaded on flush.
+static BitSet32 GetUsedTextureMaps()
+{
+  BitSet32 used;
+  for (u32 i = 0; i < bpmem.genMode.numtevstages + 1u; ++i)
+    if (bpmem.tevorders[i / 2].getEnable(i & 1))
+      used[bpmem.tevorders[i / 2].getTexMap(i & 1)] = true;
+
+  if (bpmem.genMode.numindstages > 0)
+    for (u32 i = 0; i < bpmem.genMode.numtevstages + 1u; ++i)
+      if (bpmem.tevind[i].IsActive() && bpmem.tevind[i].bt < bpmem.genMode.numindstages)
+        used[bpmem.tevindref.getTexMap(bpmem.tevind[i].bt)] = true;
+
+  return used;
+}
+
+// Returns false for registers which are not read when drawing the current batch, so that writing
+// them doesn't need to split it. Copy and clear parameters are only used by the copy trigger, which
+// flushes anyway, and the stage and texture registers are only used when the stage is enabled.
+static bool AffectsPendingDraws(u32 address)
+{
+  switch (address)
+  {
+  case BPMEM_DISPLAYCOPYFILTER:
+  case BPMEM_DISPLAYCOPYFILTER + 1:
+  case BPMEM_DISPLAYCOPYFILTER + 2:
+  case BPMEM_DISPLAYCOPYFILTER + 3:
+  case BPMEM_IND_IMASK:
+  case BPMEM_PERF0_TRI:
+  case BPMEM_PERF0_QUAD:
+  case BPMEM_BUSCLOCK0:
+  case BPMEM_EFB_TL:
+  case BPMEM_EFB_BR:
+  case BPMEM_EFB_ADDR:
+  case BPMEM_MIPMAP_STRIDE:
+  case BPMEM_COPYYSCALE:
+  case BPMEM_CLEAR_AR:
+  case BPMEM_CLEAR_GB:
+  case BPMEM_CLEAR_Z:
+  case BPMEM_COPYFILTER0:
+  case BPMEM_COPYFILTER1:
+  case BPMEM_REVBITS:
+  case BPMEM_PRELOAD_ADDR:
+  case BPMEM_PRELOAD_TMEMEVEN:
+  case BPMEM_PRELOAD_TMEMODD:
+  case BPMEM_PERF1:
+  case BPMEM_BUSCLOCK1:
+    return false;
+  default:
+    break;
+  }
+
+  const u32 num_stages = bpmem.genMode.numtevstages + 1;
+  if (address >= BPMEM_IND_CMD && address < BPMEM_IND_CMD + 16)
+    return address - BPMEM_IND_CMD < num_stages;
+  if (address >= BPMEM_TREF && address < BPMEM_TREF + 8)
+    return (address - BPMEM_TREF) * 2 < num_stages;
+  if (address >= BPMEM_TEV_COLOR_ENV && address < BPMEM_TEV_COLOR_ENV + 32)
+    return (address - BPMEM_TEV_COLOR_ENV) / 2 < num_stages;
+
+  // Texture map registers come in groups of four, for texture maps 0-3 and 4-7.
+  if ((address >= BPMEM_TX_SETMODE0 && address < BPMEM_TX_SETTLUT + 4) ||
+      (address >= BPMEM_TX_SETMODE0_4 && address < BPMEM_TX_SETTLUT_4 + 4))
+  {
+    const u32 texmap = (address & 3) | (address >= BPMEM_TX_SETMODE0_4 ? 4 : 0);
+    return GetUsedTextureMaps()[texmap];
+  }
+
+  return true;
+}
+
 static void BPWritten(const BPCmd& bp)
 {
   /*
@@ -79,11 +152,15 @@ static void BPWritten(const BPCmd& bp)
           bp.address == BPMEM_TEXINVALIDATE || bp.address == BPMEM_PRELOAD_MODE ||
           bp.address == BPMEM_CLEAR_PIXEL_PERF))
     {
+      g_vertex_manager->OnFlushAvoided();
       return;
     }
   }
 
-  FlushPipeline();
+  if (AffectsPendingDraws(bp.address))
+    FlushPipeline();
+  else
+    g_vertex_manager->OnFlushAvoided();
 
   ((u32*)&bpmem)[bp.address] = bp.newvalue;
 
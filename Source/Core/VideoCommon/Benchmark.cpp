@@ -0,0 +1,163 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/Benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+#include "VideoCommon/Statistics.h"
+
+namespace Benchmark
+{
+namespace
+{
+struct GPUFrame
+{
+  double time_ms;
+  int draw_calls;
+  int primitives;
+  int shaders_compiled;
+};
+
+std::atomic<bool> s_recording{false};
+std::mutex s_lock;
+
+// Only written by the CPU thread.
+std::vector<double> s_cpu_frame_times;
+u64 s_last_cpu_frame_us = 0;
+
+// Only written by the video thread.
+std::vector<GPUFrame> s_gpu_frames;
+u64 s_last_gpu_frame_us = 0;
+int s_last_shaders_created = 0;
+
+int GetShadersCreated()
+{
+  return g_stats.num_pixel_shaders_created + g_stats.num_vertex_shaders_created;
+}
+
+// Nearest-rank percentile of the sorted samples.
+double GetPercentile(const std::vector<double>& sorted, double percentile)
+{
+  if (sorted.empty())
+    return 0.0;
+
+  const size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+std::string FormatSummary(std::vector<double> times)
+{
+  std::sort(times.begin(), times.end());
+  const double mean =
+      times.empty() ? 0.0 : std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+  return fmt::format("{{\"frames\": {}, \"mean_ms\": {:.3f}, \"p50_ms\": {:.3f}, "
+                     "\"p90_ms\": {:.3f}, \"p95_ms\": {:.3f}, \"p99_ms\": {:.3f}, "
+                     "\"max_ms\": {:.3f}}}",
+                     times.size(), mean, GetPercentile(times, 50), GetPercentile(times, 90),
+                     GetPercentile(times, 95), GetPercentile(times, 99),
+                     times.empty() ? 0.0 : times.back());
+}
+}  // Anonymous namespace
+
+void Start()
+{
+  std::lock_guard<std::mutex> lk(s_lock);
+  s_cpu_frame_times.clear();
+  s_gpu_frames.clear();
+  s_last_cpu_frame_us = 0;
+  s_last_gpu_frame_us = 0;
+  s_last_shaders_created = GetShadersCreated();
+  s_recording = true;
+}
+
+bool IsRecording()
+{
+  return s_recording;
+}
+
+void OnCPUFrame()
+{
+  if (!s_recording)
+    return;
+
+  // The first frame only starts the clock, as there is no previous frame to measure from.
+  const u64 now = Common::Timer::GetTimeUs();
+  if (s_last_cpu_frame_us != 0)
+  {
+    std::lock_guard<std::mutex> lk(s_lock);
+    s_cpu_frame_times.push_back((now - s_last_cpu_frame_us) / 1000.0);
+  }
+  s_last_cpu_frame_us = now;
+}
+
+void OnGPUFrame()
+{
+  if (!s_recording)
+    return;
+
+  // The shader cache resets its counters when it is reloaded.
+  const int shaders_created = GetShadersCreated();
+  const int shaders_compiled = shaders_created >= s_last_shaders_created ?
+                                   shaders_created - s_last_shaders_created :
+                                   shaders_created;
+  s_last_shaders_created = shaders_created;
+
+  const u64 now = Common::Timer::GetTimeUs();
+  if (s_last_gpu_frame_us != 0)
+  {
+    std::lock_guard<std::mutex> lk(s_lock);
+    s_gpu_frames.push_back({(now - s_last_gpu_frame_us) / 1000.0,
+                            g_stats.this_frame.num_draw_calls,
+                            g_stats.this_frame.num_prims + g_stats.this_frame.num_dl_prims,
+                            shaders_compiled});
+  }
+  s_last_gpu_frame_us = now;
+}
+
+std::string Stop()
+{
+  s_recording = false;
+  std::lock_guard<std::mutex> lk(s_lock);
+
+  std::string cpu_frames;
+  for (double time : s_cpu_frame_times)
+    cpu_frames += fmt::format("{}{:.3f}", cpu_frames.empty() ? "" : ", ", time);
+
+  std::string gpu_frames;
+  std::vector<double> gpu_frame_times;
+  int draw_calls = 0;
+  int shaders_compiled = 0;
+  for (const GPUFrame& frame : s_gpu_frames)
+  {
+    gpu_frames += fmt::format("{}    {{\"time_ms\": {:.3f}, \"draw_calls\": {}, \"primitives\": "
+                              "{}, \"shaders_compiled\": {}}}",
+                              gpu_frames.empty() ? "" : ",\n", frame.time_ms, frame.draw_calls,
+                              frame.primitives, frame.shaders_compiled);
+    gpu_frame_times.push_back(frame.time_ms);
+    draw_calls += frame.draw_calls;
+    shaders_compiled += frame.shaders_compiled;
+  }
+
+  return fmt::format("{{\n"
+                     "  \"cpu_frame_time\": {},\n"
+                     "  \"gpu_frame_time\": {},\n"
+                     "  \"draw_calls\": {},\n"
+                     "  \"shaders_compiled\": {},\n"
+                     "  \"cpu_frame_times_ms\": [{}],\n"
+                     "  \"gpu_frames\": [\n{}\n  ]\n"
+                     "}}\n",
+                     FormatSummary(s_cpu_frame_times), FormatSummary(std::move(gpu_frame_times)),
+                     draw_calls, shaders_compiled, cpu_frames, gpu_frames);
+}
+}  // namespace Benchmark
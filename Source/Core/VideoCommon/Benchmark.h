@@ -0,0 +1,26 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+
+// Records per-frame timings and counters while replaying a FIFO log, so that the performance of
+// the video pipeline can be compared between versions without a GUI.
+namespace Benchmark
+{
+// Clears previous samples and starts recording.
+void Start();
+bool IsRecording();
+
+// Called on the CPU thread when the next frame starts being written to the FIFO.
+void OnCPUFrame();
+
+// Called on the video thread when a frame has been presented, before the statistics of the frame
+// are reset.
+void OnGPUFrame();
+
+// Stops recording and returns the samples and their percentiles as a JSON document.
+std::string Stop();
+}  // namespace Benchmark
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -25,6 +26,15 @@ std::array<u16, 4> s_coordinates{
     0x80,
     0xA0,
 };
+
+// Coordinates of the last readback in deferred mode, written by the video thread and read by the
+// CPU thread.
+std::array<std::atomic<u16>, 4> s_readback_coordinates{
+    0x80,
+    0xA0,
+    0x80,
+    0xA0,
+};
 }  // Anonymous namespace
 
 void Enable()
@@ -67,10 +77,29 @@ void Update(u16 left, u16 right, u16 top, u16 bottom)
   SetCoordinate(Coordinate::Bottom, new_bottom);
 }
 
+u16 GetReadbackCoordinate(Coordinate coordinate)
+{
+  return s_readback_coordinates[static_cast<u32>(coordinate)].load(std::memory_order_relaxed);
+}
+
+void SetReadbackCoordinates(const std::array<u16, 4>& coordinates)
+{
+  for (size_t i = 0; i < coordinates.size(); ++i)
+    s_readback_coordinates[i].store(coordinates[i], std::memory_order_relaxed);
+}
+
 void DoState(PointerWrap& p)
 {
   p.Do(s_is_active);
   p.DoArray(s_coordinates);
+
+  // Deferred reads return these until the first readback after loading the state completes.
+  std::array<u16, 4> readback_coordinates;
+  for (size_t i = 0; i < readback_coordinates.size(); ++i)
+    readback_coordinates[i] = s_readback_coordinates[i].load(std::memory_order_relaxed);
+  p.DoArray(readback_coordinates);
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    SetReadbackCoordinates(readback_coordinates);
 }
 
 }  // namespace BoundingBox
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 
 class PointerWrap;
@@ -38,6 +40,13 @@ void SetCoordinate(Coordinate coordinate, u16 value);
 // Updates all bounding box coordinates.
 void Update(u16 left, u16 right, u16 top, u16 bottom);
 
+// Gets the coordinate of the last bounding box read back from the GPU in deferred mode. Can be
+// called from any thread.
+u16 GetReadbackCoordinate(Coordinate coordinate);
+
+// Sets the coordinates of a completed readback, on the video thread.
+void SetReadbackCoordinates(const std::array<u16, 4>& coordinates);
+
 // Save state
 void DoState(PointerWrap& p);
 }  // namespace BoundingBox
@@ -4,9 +4,13 @@
 
 #include "VideoCommon/Fifo.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstring>
+#include <limits>
 
+#include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/Atomic.h"
 #include "Common/BlockingLoop.h"
@@ -15,17 +19,23 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Timer.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/Host.h"
 
+#include "VideoCommon/AdaptiveSyncDistance.h"
 #include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/InPlaceFifoDecoder.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -34,6 +44,9 @@ namespace Fifo
 {
 static constexpr u32 FIFO_SIZE = 2 * 1024 * 1024;
 static constexpr int GPU_TIME_SLOT_SIZE = 1000;
+// Upper bound for the amount of FIFO data decoded in place at once, so that the GPU thread still
+// checks for sync and async requests regularly.
+static constexpr u32 MAX_IN_PLACE_SIZE = 4096;
 
 static Common::BlockingLoop s_gpu_mainloop;
 
@@ -56,6 +69,13 @@ static u8* s_video_buffer_read_ptr;
 static std::atomic<u8*> s_video_buffer_write_ptr;
 static std::atomic<u8*> s_video_buffer_seen_ptr;
 static u8* s_video_buffer_pp_read_ptr;
+// In zero-copy mode, keeps track of the FIFO block at CPReadPointer that was only partially
+// decoded in place. It is only kept across runs of the GPU loop while it waits for the CPU thread
+// in SyncGPU mode. Otherwise, and when saving states, the rest of the block is moved to
+// s_video_buffer first, so savestates never see it.
+static InPlaceFifoDecoder s_in_place_fifo([](DataReader src, u32* cycles) {
+  return OpcodeDecoder::Run(src, cycles, false);
+});
 // The read_ptr is always owned by the GPU thread.  In normal mode, so is the
 // write_ptr, despite it being atomic.  In deterministic GPU thread mode,
 // things get a bit more complicated:
@@ -72,8 +92,34 @@ static std::atomic<int> s_sync_ticks;
 static bool s_syncing_suspended;
 static Common::Event s_sync_wakeup_event;
 
+// The distance at which the CPU thread blocks until the GPU thread has caught up. This is
+// SyncGpuMaxDistance, unless adaptive syncing is enabled, in which case the CPU thread tunes it
+// between ADAPTIVE_MIN_DISTANCE and SyncGpuMaxDistance based on how often and how long it stalls.
+static std::atomic<int> s_sync_max_distance;
+
+// Only accessed by the CPU thread, which publishes its distance to s_sync_max_distance.
+static AdaptiveSyncDistance s_adaptive_sync;
+
+// Stalls of the CPU thread since the GPU thread last published them to the statistics, which are
+// owned by the GPU thread.
+static std::atomic<int> s_sync_stats_stalls;
+static std::atomic<u64> s_sync_stats_stall_us;
+
+// The adaptive distance is reevaluated every 1/ADAPTIVE_WINDOWS_PER_SECOND of emulated time.
+static constexpr int ADAPTIVE_WINDOWS_PER_SECOND = 20;
+static constexpr int ADAPTIVE_MIN_DISTANCE = 4 * GPU_TIME_SLOT_SIZE;
+
+static void MoveInPlaceRemainderToVideoBuffer();
+
 void DoState(PointerWrap& p)
 {
+  // A block which was only partially decoded in place is finished in s_video_buffer, so that the
+  // state looks exactly like it does with the copying path.
+  if (p.mode == PointerWrap::MODE_READ)
+    s_in_place_fifo.Reset();
+  else
+    MoveInPlaceRemainderToVideoBuffer();
+
   p.DoArray(s_video_buffer, FIFO_SIZE);
   u8* write_ptr = s_video_buffer_write_ptr;
   p.DoPointer(write_ptr, s_video_buffer);
@@ -118,6 +164,10 @@ void Init()
   if (SConfig::GetInstance().bCPUThread)
     s_gpu_mainloop.Prepare();
   s_sync_ticks.store(0);
+  s_sync_max_distance.store(SConfig::GetInstance().iSyncGpuMaxDistance);
+  s_adaptive_sync.Reset(SConfig::GetInstance().iSyncGpuMaxDistance);
+  s_sync_stats_stalls.store(0);
+  s_sync_stats_stall_us.store(0);
 }
 
 void Shutdown()
@@ -281,8 +331,108 @@ static void ReadDataFromFifoOnCPU(u32 readPtr)
   s_video_buffer_write_ptr = write_ptr + len;
 }
 
+// Returns a pointer to FIFO data in emulated RAM that can be decoded in place, or nullptr if the
+// data is not entirely in MEM1. Like s_video_buffer, the data is followed by a few bytes that
+// are safe to overread.
+static u8* GetInPlaceFifoPointer(u32 address, u32 size)
+{
+  address &= 0x3FFFFFFF;
+  if (u64{address} + size + 4 > Memory::GetRamSizeReal())
+    return nullptr;
+  return Memory::GetPointer(address);
+}
+
+// Returns the amount of FIFO data at read_ptr to decode in place at once. The copying path updates
+// the CP status after every 32 byte block, so the data is cut off after the first block that
+// makes the read-write distance cross an enabled watermark, raising or clearing the watermark
+// interrupt at the same point.
+static u32 GetInPlaceFifoSize(u32 read_ptr)
+{
+  const CommandProcessor::SCPFifoStruct& fifo = CommandProcessor::fifo;
+  const u32 distance = Common::AtomicLoad(fifo.CPReadWriteDistance);
+  u32 size = std::min({distance, fifo.CPEnd + 32 - read_ptr, MAX_IN_PLACE_SIZE});
+
+  // Underflow once the distance drops below the low watermark.
+  if (fifo.bFF_LoWatermarkInt && distance >= fifo.CPLoWatermark)
+    size = std::min(size, Common::AlignDown(distance - fifo.CPLoWatermark, 32) + 32);
+  // Overflow until the distance is no longer above the high watermark.
+  if (fifo.bFF_HiWatermarkInt && distance > fifo.CPHiWatermark)
+    size = std::min(size, Common::AlignUp(distance - fifo.CPHiWatermark, 32));
+
+  return size;
+}
+
+static InPlaceFifoDecoder::Location GetInPlaceFifoLocation(u32 read_ptr)
+{
+  const CommandProcessor::SCPFifoStruct& fifo = CommandProcessor::fifo;
+  return {fifo.CPBase, fifo.CPEnd, read_ptr};
+}
+
+static void AdvanceFifoReadPointer(u32 read_ptr, u32 size)
+{
+  CommandProcessor::SCPFifoStruct& fifo = CommandProcessor::fifo;
+
+  // Reads never go past the end of the ring buffer, so they can end exactly there at most.
+  read_ptr = read_ptr + size - 32 == fifo.CPEnd ? fifo.CPBase : read_ptr + size;
+
+  ASSERT_MSG(COMMANDPROCESSOR, fifo.CPReadWriteDistance >= size,
+             "Negative fifo.CPReadWriteDistance = %i in FIFO Loop !\nThat can produce "
+             "instability in the game. Please report it.",
+             fifo.CPReadWriteDistance - size);
+
+  Common::AtomicStore(fifo.CPReadPointer, read_ptr);
+  Common::AtomicAdd(fifo.CPReadWriteDistance, static_cast<u32>(-static_cast<s32>(size)));
+  if (s_video_buffer_write_ptr == s_video_buffer_read_ptr &&
+      s_in_place_fifo.GetOffset(GetInPlaceFifoLocation(read_ptr)) == 0)
+  {
+    Common::AtomicStore(fifo.SafeCPReadPointer, fifo.CPReadPointer);
+  }
+}
+
+// Decodes the FIFO data at read_ptr in place. Only the contiguous data up to the end of the ring
+// buffer is decoded. A command which continues past the available data is picked up again once
+// more data arrives, or moved to s_video_buffer if it wraps around or never fit in the first place.
+// Returns the number of bytes to advance the read pointer by.
+static u32 RunFifoInPlace(u32 read_ptr, u8* data, u32 size, u32* cycles)
+{
+  const InPlaceFifoDecoder::Location location = GetInPlaceFifoLocation(read_ptr);
+  const u32 start = s_in_place_fifo.GetOffset(location);
+  const u32 stop = s_in_place_fifo.Decode(location, data, size, cycles);
+
+  if (stop == start)
+  {
+    // No progress at all, so finish the command in s_video_buffer like the copying path does.
+    const u32 remaining = size - start;
+    std::memcpy(s_video_buffer, data + start, remaining);
+    s_video_buffer_read_ptr = s_video_buffer;
+    s_video_buffer_write_ptr = s_video_buffer + remaining;
+    s_in_place_fifo.Reset();
+    return size;
+  }
+
+  return Common::AlignDown(stop, 32);
+}
+
+// Moves the rest of a partially decoded FIFO block to s_video_buffer, which is where the copying
+// path expects incomplete commands to be.
+static void MoveInPlaceRemainderToVideoBuffer()
+{
+  const u32 read_ptr = CommandProcessor::fifo.CPReadPointer;
+  const u32 offset = s_in_place_fifo.GetOffset(GetInPlaceFifoLocation(read_ptr));
+  if (offset == 0)
+    return;
+
+  const u32 remaining = 32 - offset;
+  Memory::CopyFromEmu(s_video_buffer, read_ptr + offset, remaining);
+  s_video_buffer_read_ptr = s_video_buffer;
+  s_video_buffer_write_ptr = s_video_buffer + remaining;
+  s_in_place_fifo.Reset();
+  AdvanceFifoReadPointer(read_ptr, 32);
+}
+
 void ResetVideoBuffer()
 {
+  s_in_place_fifo.Reset();
   s_video_buffer_read_ptr = s_video_buffer;
   s_video_buffer_write_ptr = s_video_buffer;
   s_video_buffer_seen_ptr = s_video_buffer;
@@ -291,6 +441,16 @@ void ResetVideoBuffer()
   s_fifo_aux_read_ptr = s_fifo_aux_data;
 }
 
+// Called by the GPU thread, which owns the statistics.
+static void PublishSyncStatistics()
+{
+  SETSTAT(g_stats.gpu_sync_distance, s_sync_max_distance.load(std::memory_order_relaxed));
+  ADDSTAT(g_stats.this_frame.num_gpu_sync_stalls, s_sync_stats_stalls.exchange(0));
+  ADDSTAT(g_stats.this_frame.gpu_sync_stall_us,
+          static_cast<int>(std::min<u64>(s_sync_stats_stall_us.exchange(0),
+                                         std::numeric_limits<int>::max())));
+}
+
 // Description: Main FIFO update loop
 // Purpose: Keep the Core HW updated about the CPU-GPU distance
 void RunGpuLoop()
@@ -298,13 +458,20 @@ void RunGpuLoop()
   AsyncRequests::GetInstance()->SetEnable(true);
   AsyncRequests::GetInstance()->SetPassthrough(false);
 
+  // The copy in s_video_buffer is still needed in deterministic GPU thread mode, where the CPU
+  // thread preprocesses the data ahead of the GPU thread.
+  const bool zero_copy = Config::Get(Config::MAIN_ZERO_COPY_FIFO);
+
   s_gpu_mainloop.Run(
-      [] {
+      [zero_copy] {
         const SConfig& param = SConfig::GetInstance();
 
         // Run events from the CPU thread.
         AsyncRequests::GetInstance()->PullEvents();
 
+        if (param.bSyncGPU && param.bSyncGPUAdaptive)
+          PublishSyncStatistics();
+
         // Do nothing while paused
         if (!s_emu_running_state.IsSet())
           return;
@@ -327,44 +494,72 @@ void RunGpuLoop()
           CommandProcessor::SCPFifoStruct& fifo = CommandProcessor::fifo;
           CommandProcessor::SetCPStatusFromGPU();
 
+          bool waiting_for_cpu = false;
+
           // check if we are able to run this buffer
           while (!CommandProcessor::IsInterruptWaiting() && fifo.bFF_GPReadEnable &&
                  fifo.CPReadWriteDistance && !AtBreakpoint())
           {
             if (param.bSyncGPU && s_sync_ticks.load() < param.iSyncGpuMinDistance)
+            {
+              waiting_for_cpu = true;
               break;
+            }
 
             u32 cyclesExecuted = 0;
-            u32 readPtr = fifo.CPReadPointer;
-            ReadDataFromFifo(readPtr);
-
-            if (readPtr == fifo.CPEnd)
-              readPtr = fifo.CPBase;
-            else
-              readPtr += 32;
+            const u32 readPtr = fifo.CPReadPointer;
 
-            ASSERT_MSG(COMMANDPROCESSOR, (s32)fifo.CPReadWriteDistance - 32 >= 0,
-                       "Negative fifo.CPReadWriteDistance = %i in FIFO Loop !\nThat can produce "
-                       "instability in the game. Please report it.",
-                       fifo.CPReadWriteDistance - 32);
+            // Breakpoints are checked for every block, so they need the copying path.
+            const bool in_place = zero_copy && !fifo.bFF_BPEnable;
+            const u32 in_place_size = GetInPlaceFifoSize(readPtr);
+            u8* const in_place_data =
+                in_place ? GetInPlaceFifoPointer(readPtr, in_place_size) : nullptr;
 
-            u8* write_ptr = s_video_buffer_write_ptr;
-            s_video_buffer_read_ptr = OpcodeDecoder::Run(
-                DataReader(s_video_buffer_read_ptr, write_ptr), &cyclesExecuted, false);
-
-            Common::AtomicStore(fifo.CPReadPointer, readPtr);
-            Common::AtomicAdd(fifo.CPReadWriteDistance, static_cast<u32>(-32));
-            if ((write_ptr - s_video_buffer_read_ptr) == 0)
-              Common::AtomicStore(fifo.SafeCPReadPointer, fifo.CPReadPointer);
+            if (in_place_data && s_video_buffer_read_ptr == s_video_buffer_write_ptr)
+            {
+              const u32 read_size =
+                  RunFifoInPlace(readPtr, in_place_data, in_place_size, &cyclesExecuted);
+              if (read_size != 0)
+                AdvanceFifoReadPointer(readPtr, read_size);
+            }
+            else if (s_in_place_fifo.GetOffset(GetInPlaceFifoLocation(readPtr)) != 0)
+            {
+              // Decoding in place is no longer possible, and the block that was only partially
+              // decoded might have been the last one.
+              MoveInPlaceRemainderToVideoBuffer();
+              continue;
+            }
+            else
+            {
+              ReadDataFromFifo(readPtr);
+
+              u8* write_ptr = s_video_buffer_write_ptr;
+              s_video_buffer_read_ptr = OpcodeDecoder::Run(
+                  DataReader(s_video_buffer_read_ptr, write_ptr), &cyclesExecuted, false);
+
+              // If only the end of the block that was just copied is left, go back to decoding
+              // in place from there instead of copying until a command happens to end exactly at
+              // the end of a block.
+              const u32 remaining = static_cast<u32>(write_ptr - s_video_buffer_read_ptr);
+              if (in_place_data && remaining != 0 && remaining <= 32)
+              {
+                s_in_place_fifo.SetOffset(GetInPlaceFifoLocation(readPtr), 32 - remaining);
+                s_video_buffer_read_ptr = s_video_buffer_write_ptr = s_video_buffer;
+              }
+              else
+              {
+                AdvanceFifoReadPointer(readPtr, 32);
+              }
+            }
 
             CommandProcessor::SetCPStatusFromGPU();
 
             if (param.bSyncGPU)
             {
               cyclesExecuted = (int)(cyclesExecuted / param.fSyncGpuOverclock);
+              const int max_distance = s_sync_max_distance.load(std::memory_order_relaxed);
               int old = s_sync_ticks.fetch_sub(cyclesExecuted);
-              if (old >= param.iSyncGpuMaxDistance &&
-                  old - (int)cyclesExecuted < param.iSyncGpuMaxDistance)
+              if (old >= max_distance && old - (int)cyclesExecuted < max_distance)
                 s_sync_wakeup_event.Set();
             }
 
@@ -375,11 +570,18 @@ void RunGpuLoop()
             AsyncRequests::GetInstance()->PullEvents();
           }
 
+          // Leaves the FIFO in the same state as the copying path would. This isn't needed when
+          // the GPU thread only waits for the CPU thread to catch up: CPReadPointer still points
+          // to the partially decoded block, so decoding it in place continues on the next run,
+          // unless the CPU thread moves the FIFO or its read pointer before then.
+          if (!waiting_for_cpu)
+            MoveInPlaceRemainderToVideoBuffer();
+
           // fast skip remaining GPU time if fifo is empty
           if (s_sync_ticks.load() > 0)
           {
             int old = s_sync_ticks.exchange(0);
-            if (old >= param.iSyncGpuMaxDistance)
+            if (old >= s_sync_max_distance.load(std::memory_order_relaxed))
               s_sync_wakeup_event.Set();
           }
 
@@ -530,6 +732,18 @@ bool UseDeterministicGPUThread()
   return s_use_deterministic_gpu_thread;
 }
 
+static void UpdateAdaptiveSyncDistance(int ticks)
+{
+  const SConfig& param = SConfig::GetInstance();
+
+  const int window_size = SystemTimers::GetTicksPerSecond() / ADAPTIVE_WINDOWS_PER_SECOND;
+  const int upper = param.iSyncGpuMaxDistance;
+  const int lower =
+      std::min(upper, std::max(param.iSyncGpuMinDistance, 0) + ADAPTIVE_MIN_DISTANCE);
+  s_adaptive_sync.Update(ticks, window_size, lower, upper, GPU_TIME_SLOT_SIZE);
+  s_sync_max_distance.store(s_adaptive_sync.GetDistance(), std::memory_order_relaxed);
+}
+
 /* This function checks the emulated CPU - GPU distance and may wake up the GPU,
  * or block the CPU if required. It should be called by the CPU thread regularly.
  * @ticks The gone emulated CPU time.
@@ -554,9 +768,33 @@ static int WaitForGpuThread(int ticks)
   if (now < param.iSyncGpuMinDistance)
     return GPU_TIME_SLOT_SIZE + param.iSyncGpuMinDistance - now;
 
-  // Wait for GPU
-  if (now >= param.iSyncGpuMaxDistance)
-    s_sync_wakeup_event.Wait();
+  if (!param.bSyncGPUAdaptive)
+  {
+    // Wait for GPU
+    if (now >= param.iSyncGpuMaxDistance)
+      s_sync_wakeup_event.Wait();
+
+    return GPU_TIME_SLOT_SIZE;
+  }
+
+  UpdateAdaptiveSyncDistance(ticks);
+
+  // The GPU thread may have used a stale distance to decide whether to wake us up, so the
+  // condition is rechecked instead of relying on a single wakeup.
+  if (now >= s_sync_max_distance.load(std::memory_order_relaxed))
+  {
+    const u64 stall_start = Common::Timer::GetTimeUs();
+    while (s_sync_ticks.load() >= s_sync_max_distance.load(std::memory_order_relaxed) &&
+           !s_gpu_mainloop.IsDone())
+    {
+      s_sync_wakeup_event.WaitFor(std::chrono::milliseconds(1));
+    }
+    const u64 stall_us = Common::Timer::GetTimeUs() - stall_start;
+
+    s_adaptive_sync.AddStall(stall_us);
+    s_sync_stats_stalls.fetch_add(1, std::memory_order_relaxed);
+    s_sync_stats_stall_us.fetch_add(stall_us, std::memory_order_relaxed);
+  }
 
   return GPU_TIME_SLOT_SIZE;
 }
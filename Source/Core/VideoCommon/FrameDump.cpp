@@ -8,8 +8,14 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -18,6 +24,7 @@ extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/mathematics.h>
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 }
 
@@ -25,6 +32,7 @@ extern "C" {
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Thread.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/HW/SystemTimers.h"
@@ -33,14 +41,113 @@ extern "C" {
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
+namespace
+{
+// Threads which convert bands of rows of a frame in parallel. They are started along with the video
+// file, so that converting a frame doesn't have to create and join threads.
+class ConversionWorkers
+{
+public:
+  ~ConversionWorkers() { Stop(); }
+
+  // Includes the dumping thread, which converts a band as well.
+  void Start(int num_threads);
+  void Stop();
+  int GetThreadCount() const { return static_cast<int>(m_threads.size()) + 1; }
+
+  // Runs work(index) for every index below GetThreadCount(), and returns once all are done.
+  void Run(const std::function<void(int index)>& work);
+
+private:
+  void ThreadFunc(int index, u64 generation);
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_work_done;
+  const std::function<void(int)>* m_work = nullptr;
+  u64 m_generation = 0;
+  int m_busy_threads = 0;
+  bool m_exit = false;
+};
+
+void ConversionWorkers::Start(int num_threads)
+{
+  Stop();
+
+  m_exit = false;
+  for (int i = 1; i < num_threads; i++)
+    m_threads.emplace_back(&ConversionWorkers::ThreadFunc, this, i, m_generation);
+}
+
+void ConversionWorkers::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_exit = true;
+  }
+  m_work_available.notify_all();
+
+  for (std::thread& thread : m_threads)
+    thread.join();
+  m_threads.clear();
+}
+
+void ConversionWorkers::Run(const std::function<void(int index)>& work)
+{
+  if (m_threads.empty())
+  {
+    work(0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_work = &work;
+    m_busy_threads = static_cast<int>(m_threads.size());
+    m_generation++;
+  }
+  m_work_available.notify_all();
+
+  work(0);
+
+  std::unique_lock<std::mutex> lk(m_mutex);
+  m_work_done.wait(lk, [this] { return m_busy_threads == 0; });
+  m_work = nullptr;
+}
+
+void ConversionWorkers::ThreadFunc(int index, u64 generation)
+{
+  Common::SetCurrentThreadName("FrameDumpConvert");
+
+  std::unique_lock<std::mutex> lk(m_mutex);
+  while (true)
+  {
+    m_work_available.wait(lk, [&] { return m_exit || m_generation != generation; });
+    if (m_exit)
+      return;
+    generation = m_generation;
+
+    const std::function<void(int)>& work = *m_work;
+    lk.unlock();
+    work(index);
+    lk.lock();
+
+    if (--m_busy_threads == 0)
+      m_work_done.notify_one();
+  }
+}
+}  // namespace
+
 struct FrameDumpContext
 {
   AVFormatContext* format = nullptr;
   AVStream* stream = nullptr;
   AVCodecContext* codec = nullptr;
-  AVFrame* src_frame = nullptr;
   AVFrame* scaled_frame = nullptr;
-  SwsContext* sws = nullptr;
+  // One context for each band of rows which is converted in parallel.
+  std::vector<SwsContext*> sws;
+  ConversionWorkers conversion_workers;
 
   s64 last_pts = AV_NOPTS_VALUE;
 
@@ -64,6 +171,67 @@ AVRational GetTimeBaseForCurrentRefreshRate()
   return AVRational{num, den};
 }
 
+int GetThreadCount()
+{
+  if (g_Config.iFrameDumpsThreads > 0)
+    return g_Config.iFrameDumpsThreads;
+
+  return std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+}
+
+// Converts the RGBA frame to the pixel format of the encoder. Unless the frame has to be scaled,
+// it is split into bands of rows which are converted on the conversion workers, as converting a
+// large frame on the dumping thread alone can take a significant part of the frame time.
+void ConvertFrame(FrameDumpContext* context, const FrameDump::FrameData& frame)
+{
+  constexpr AVPixelFormat src_format = AV_PIX_FMT_RGBA;
+  const AVPixelFormat dst_format = context->codec->pix_fmt;
+  AVFrame* const dst_frame = context->scaled_frame;
+
+  const bool scaled = frame.width != context->width || frame.height != context->height;
+  int num_bands = 1;
+  int band_height = frame.height;
+  if (!scaled)
+  {
+    // Bands start on even rows, so that they don't share vertically subsampled chroma rows.
+    num_bands = std::clamp(frame.height / 64, 1, context->conversion_workers.GetThreadCount());
+    band_height = ((frame.height + num_bands - 1) / num_bands + 1) & ~1;
+    num_bands = (frame.height + band_height - 1) / band_height;
+  }
+
+  for (size_t i = num_bands; i < context->sws.size(); i++)
+    sws_freeContext(context->sws[i]);
+  context->sws.resize(num_bands, nullptr);
+
+  const AVPixFmtDescriptor* const dst_desc = av_pix_fmt_desc_get(dst_format);
+  const auto convert_band = [&](int band) {
+    const int y = band * band_height;
+    const int height = std::min(band_height, frame.height - y);
+    SwsContext*& sws = context->sws[band];
+    sws = sws_getCachedContext(sws, frame.width, height, src_format, context->width,
+                               scaled ? context->height : height, dst_format, SWS_BICUBIC,
+                               nullptr, nullptr, nullptr);
+    if (!sws)
+      return;
+
+    const u8* const src_data[4] = {frame.data + static_cast<ptrdiff_t>(y) * frame.stride};
+    const int src_linesize[4] = {frame.stride};
+    u8* dst_data[4] = {};
+    for (int plane = 0; plane < 4 && dst_frame->data[plane]; plane++)
+    {
+      const int plane_y = (plane == 1 || plane == 2) ? y >> dst_desc->log2_chroma_h : y;
+      dst_data[plane] =
+          dst_frame->data[plane] + static_cast<ptrdiff_t>(plane_y) * dst_frame->linesize[plane];
+    }
+    sws_scale(sws, src_data, src_linesize, 0, height, dst_data, dst_frame->linesize);
+  };
+
+  context->conversion_workers.Run([&](int band) {
+    if (band < num_bands)
+      convert_band(band);
+  });
+}
+
 void InitAVCodec()
 {
   static bool first_run = true;
@@ -216,6 +384,8 @@ bool FrameDump::CreateVideoFile()
   m_context->codec->gop_size = 1;
   m_context->codec->level = 1;
   m_context->codec->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGR0 : AV_PIX_FMT_YUV420P;
+  m_context->codec->thread_count = g_Config.iFrameDumpsThreads;
+  m_context->codec->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
 
   if (output_format->flags & AVFMT_GLOBALHEADER)
     m_context->codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
@@ -226,7 +396,6 @@ bool FrameDump::CreateVideoFile()
     return false;
   }
 
-  m_context->src_frame = av_frame_alloc();
   m_context->scaled_frame = av_frame_alloc();
 
   m_context->scaled_frame->format = m_context->codec->pix_fmt;
@@ -236,6 +405,8 @@ bool FrameDump::CreateVideoFile()
   if (av_frame_get_buffer(m_context->scaled_frame, 1))
     return false;
 
+  m_context->conversion_workers.Start(GetThreadCount());
+
   m_context->stream = avformat_new_stream(m_context->format, codec);
   if (!m_context->stream ||
       avcodec_parameters_from_context(m_context->stream->codecpar, m_context->codec) < 0)
@@ -302,24 +473,16 @@ void FrameDump::AddFrame(const FrameData& frame)
     }
   }
 
-  constexpr AVPixelFormat pix_fmt = AV_PIX_FMT_RGBA;
-
-  m_context->src_frame->data[0] = const_cast<u8*>(frame.data);
-  m_context->src_frame->linesize[0] = frame.stride;
-  m_context->src_frame->format = pix_fmt;
-  m_context->src_frame->width = m_context->width;
-  m_context->src_frame->height = m_context->height;
-
-  // Convert image from RGBA to desired pixel format.
-  m_context->sws = sws_getCachedContext(
-      m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
-      m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (m_context->sws)
+  // The encoder threads may still reference the buffers of the previous frame.
+  if (const int error = av_frame_make_writable(m_context->scaled_frame))
   {
-    sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
-              frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not make frame writable: {}", error);
+    return;
   }
 
+  // Convert image from RGBA to desired pixel format.
+  ConvertFrame(m_context.get(), frame);
+
   m_context->last_pts = pts;
   m_context->scaled_frame->pts = pts;
 
@@ -388,7 +551,8 @@ bool FrameDump::IsStarted() const
 
 void FrameDump::CloseVideoFile()
 {
-  av_frame_free(&m_context->src_frame);
+  m_context->conversion_workers.Stop();
+
   av_frame_free(&m_context->scaled_frame);
 
   avcodec_free_context(&m_context->codec);
@@ -398,8 +562,8 @@ void FrameDump::CloseVideoFile()
 
   avformat_free_context(m_context->format);
 
-  if (m_context->sws)
-    sws_freeContext(m_context->sws);
+  for (SwsContext* sws : m_context->sws)
+    sws_freeContext(sws);
 
   m_context.reset();
 }
@@ -4,7 +4,9 @@
 
 #include "VideoCommon/FramebufferManager.h"
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
@@ -18,6 +20,7 @@
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -85,6 +88,7 @@ void FramebufferManager::RecreateEFBFramebuffer()
 {
   FlushEFBPokes();
   InvalidatePeekCache(true);
+  DiscardPopulatedEFBCacheTiles();
 
   DestroyReadbackFramebuffer();
   DestroyEFBFramebuffer();
@@ -305,6 +309,7 @@ bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
   std::swap(m_efb_framebuffer, m_efb_convert_framebuffer);
   g_renderer->EndUtilityDrawing();
   InvalidatePeekCache(true);
+  DiscardPopulatedEFBCacheTiles();
   return true;
 }
 
@@ -382,9 +387,7 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
   if (g_ActiveConfig.backend_info.bUsesLowerLeftOrigin)
     y = EFB_HEIGHT - 1 - y;
 
-  u32 tile_index;
-  if (!IsEFBCacheTilePresent(false, x, y, &tile_index))
-    PopulateEFBCache(false, tile_index);
+  PrepareEFBCacheTile(false, x, y);
 
   u32 value;
   m_efb_color_cache.readback_texture->ReadTexel(x, y, &value);
@@ -397,21 +400,78 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
   if (g_ActiveConfig.backend_info.bUsesLowerLeftOrigin)
     y = EFB_HEIGHT - 1 - y;
 
-  u32 tile_index;
-  if (!IsEFBCacheTilePresent(true, x, y, &tile_index))
-    PopulateEFBCache(true, tile_index);
+  PrepareEFBCacheTile(true, x, y);
 
   float value;
   m_efb_depth_cache.readback_texture->ReadTexel(x, y, &value);
   return value;
 }
 
+void FramebufferManager::PrepareEFBCacheTile(bool depth, u32 x, u32 y)
+{
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  u32 tile_index;
+  const bool present = IsEFBCacheTilePresent(depth, x, y, &tile_index);
+  data.tiles_read[tile_index] = true;
+  if (present)
+  {
+    INCSTAT(g_stats.this_frame.num_efb_cache_hits);
+    return;
+  }
+
+  g_vertex_manager->OnEFBCacheMiss();
+  if (g_ActiveConfig.bEFBAccessOneFrameLate && data.tiles_populated[tile_index])
+  {
+    // The tile is read back at the same point next frame instead.
+    INCSTAT(g_stats.this_frame.num_efb_cache_stale_hits);
+    return;
+  }
+
+  INCSTAT(g_stats.this_frame.num_efb_cache_misses);
+  PopulateEFBCache(depth, tile_index);
+}
+
+void FramebufferManager::PrefetchEFBCache()
+{
+  for (const bool depth : {false, true})
+  {
+    EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+    for (u32 tile_index = 0; tile_index < data.tiles_to_prefetch.size(); tile_index++)
+    {
+      if (!data.tiles_to_prefetch[tile_index])
+        continue;
+
+      if (data.valid && (!IsUsingTiledEFBCache() || data.tiles[tile_index]))
+        continue;
+
+      // The staging texture waits for the copies when the CPU reads from it.
+      CopyEFBCacheTile(depth, tile_index);
+      data.valid = true;
+      data.out_of_date = false;
+      data.tiles_populated[tile_index] = true;
+      if (IsUsingTiledEFBCache())
+        data.tiles[tile_index] = true;
+      INCSTAT(g_stats.this_frame.num_efb_cache_prefetches);
+    }
+  }
+}
+
+void FramebufferManager::OnEndFrame()
+{
+  for (EFBCacheData* data : {&m_efb_color_cache, &m_efb_depth_cache})
+  {
+    std::swap(data->tiles_to_prefetch, data->tiles_read);
+    std::fill(data->tiles_read.begin(), data->tiles_read.end(), false);
+  }
+}
+
 void FramebufferManager::SetEFBCacheTileSize(u32 size)
 {
   if (m_efb_cache_tile_size == size)
     return;
 
   InvalidatePeekCache(true);
+  DiscardPopulatedEFBCacheTiles();
   m_efb_cache_tile_size = size;
   DestroyReadbackFramebuffer();
   if (!CreateReadbackFramebuffer())
@@ -438,6 +498,12 @@ void FramebufferManager::InvalidatePeekCache(bool forced)
   }
 }
 
+void FramebufferManager::DiscardPopulatedEFBCacheTiles()
+{
+  for (EFBCacheData* data : {&m_efb_color_cache, &m_efb_depth_cache})
+    std::fill(data->tiles_populated.begin(), data->tiles_populated.end(), false);
+}
+
 void FramebufferManager::FlagPeekCacheAsOutOfDate()
 {
   if (m_efb_color_cache.valid)
@@ -557,11 +623,12 @@ bool FramebufferManager::CreateReadbackFramebuffer()
   if (!m_efb_color_cache.readback_texture || !m_efb_depth_cache.readback_texture)
     return false;
 
+  u32 total_tiles = 1;
   if (IsUsingTiledEFBCache())
   {
     const u32 tiles_wide = ((EFB_WIDTH + (m_efb_cache_tile_size - 1)) / m_efb_cache_tile_size);
     const u32 tiles_high = ((EFB_HEIGHT + (m_efb_cache_tile_size - 1)) / m_efb_cache_tile_size);
-    const u32 total_tiles = tiles_wide * tiles_high;
+    total_tiles = tiles_wide * tiles_high;
     m_efb_color_cache.tiles.resize(total_tiles);
     std::fill(m_efb_color_cache.tiles.begin(), m_efb_color_cache.tiles.end(), false);
     m_efb_depth_cache.tiles.resize(total_tiles);
@@ -569,6 +636,13 @@ bool FramebufferManager::CreateReadbackFramebuffer()
     m_efb_cache_tiles_wide = tiles_wide;
   }
 
+  for (EFBCacheData* data : {&m_efb_color_cache, &m_efb_depth_cache})
+  {
+    data->tiles_read.assign(total_tiles, false);
+    data->tiles_to_prefetch.assign(total_tiles, false);
+    data->tiles_populated.assign(total_tiles, false);
+  }
+
   return true;
 }
 
@@ -584,10 +658,8 @@ void FramebufferManager::DestroyReadbackFramebuffer()
   DestroyCache(m_efb_depth_cache);
 }
 
-void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
+void FramebufferManager::CopyEFBCacheTile(bool depth, u32 tile_index)
 {
-  g_vertex_manager->OnCPUEFBAccess();
-
   // Force the path through the intermediate texture, as we can't do an image copy from a depth
   // buffer directly to a staging texture (must be the whole resource).
   const bool force_intermediate_copy =
@@ -641,11 +713,19 @@ void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
   {
     data.readback_texture->CopyFromTexture(src_texture, rect, 0, 0, rect);
   }
+}
+
+void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
+{
+  g_vertex_manager->OnCPUEFBAccess();
+  CopyEFBCacheTile(depth, tile_index);
 
   // Wait until the copy is complete.
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
   data.readback_texture->Flush();
   data.valid = true;
   data.out_of_date = false;
+  data.tiles_populated[tile_index] = true;
   if (IsUsingTiledEFBCache())
     data.tiles[tile_index] = true;
 }
@@ -930,6 +1010,7 @@ void FramebufferManager::DoLoadState(PointerWrap& p)
 {
   // Invalidate any peek cache tiles.
   InvalidatePeekCache(true);
+  DiscardPopulatedEFBCacheTiles();
 
   // Deserialize the color and depth textures. This could fail.
   auto color_tex = g_texture_cache->DeserializeTexture(p);
@@ -93,6 +93,11 @@ public:
   void InvalidatePeekCache(bool forced = true);
   void FlagPeekCacheAsOutOfDate();
 
+  // Starts reading back the tiles which the CPU accessed in the previous frame, without waiting
+  // for the copies to complete. Called at the points where the CPU missed the cache last frame.
+  void PrefetchEFBCache();
+  void OnEndFrame();
+
   // Writes a value to the framebuffer. This will never block, and writes will be batched.
   void PokeEFBColor(u32 x, u32 y, u32 color);
   void PokeEFBDepth(u32 x, u32 y, float depth);
@@ -118,6 +123,13 @@ protected:
     std::unique_ptr<AbstractStagingTexture> readback_texture;
     std::unique_ptr<AbstractPipeline> copy_pipeline;
     std::vector<bool> tiles;
+    // Tiles read by the CPU in this and the previous frame, indexed like tiles, but with a single
+    // entry when the cache is not tiled.
+    std::vector<bool> tiles_read;
+    std::vector<bool> tiles_to_prefetch;
+    // Tiles which have been read back at some point, so the readback texture holds an older
+    // version of them that can be returned when the EFB access may be one frame late.
+    std::vector<bool> tiles_populated;
     bool out_of_date;
     bool valid;
   };
@@ -143,7 +155,12 @@ protected:
   bool IsUsingTiledEFBCache() const;
   bool IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* tile_index) const;
   MathUtil::Rectangle<int> GetEFBCacheTileRect(u32 tile_index) const;
+  void PrepareEFBCacheTile(bool depth, u32 x, u32 y);
+  void CopyEFBCacheTile(bool depth, u32 tile_index);
   void PopulateEFBCache(bool depth, u32 tile_index);
+  // Forgets the older tile contents returned by one frame late EFB accesses. This is only done when
+  // they become meaningless, e.g. after a format change, not on the invalidation after each draw.
+  void DiscardPopulatedEFBCacheTiles();
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
@@ -0,0 +1,33 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/InPlaceFifoDecoder.h"
+
+namespace Fifo
+{
+u32 InPlaceFifoDecoder::GetOffset(const Location& location)
+{
+  if (m_offset != 0 && location != m_location)
+    m_offset = 0;
+  return m_offset;
+}
+
+void InPlaceFifoDecoder::SetOffset(const Location& location, u32 offset)
+{
+  m_location = location;
+  m_offset = offset;
+}
+
+u32 InPlaceFifoDecoder::Decode(const Location& location, u8* data, u32 size, u32* cycles)
+{
+  const u32 start = GetOffset(location);
+  const u32 stop = static_cast<u32>(m_decode(DataReader(data + start, data + size), cycles) - data);
+
+  // The data never goes past the end of the ring buffer, so the block with the rest of an
+  // incomplete command is always at a higher address than location.read_ptr.
+  const u32 block = stop & ~31u;
+  SetOffset({location.base, location.end, location.read_ptr + block}, stop - block);
+  return stop;
+}
+}  // namespace Fifo
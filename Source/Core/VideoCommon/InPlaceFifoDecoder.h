@@ -0,0 +1,59 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/DataReader.h"
+
+namespace Fifo
+{
+// Decodes FIFO data directly out of emulated RAM instead of copying it to the video buffer first.
+//
+// The read pointer only ever advances by whole 32 byte blocks. When a command continues past the
+// available data, the number of bytes of its block that were already decoded is remembered
+// together with the block, so that decoding can pick up from there once more data arrives. The
+// CPU thread may move the FIFO or its read pointer in the meantime, in which case the rest of
+// the block no longer belongs to the data that is decoded next and is dropped.
+class InPlaceFifoDecoder
+{
+public:
+  // Decodes as many whole commands as possible and returns where decoding stopped.
+  using DecodeFunction = u8* (*)(DataReader src, u32* cycles);
+
+  struct Location
+  {
+    bool operator==(const Location& other) const
+    {
+      return base == other.base && end == other.end && read_ptr == other.read_ptr;
+    }
+    bool operator!=(const Location& other) const { return !(*this == other); }
+
+    u32 base;
+    u32 end;
+    u32 read_ptr;
+  };
+
+  explicit InPlaceFifoDecoder(DecodeFunction decode) : m_decode(decode) {}
+
+  // Returns the number of bytes of the block at location.read_ptr which have already been
+  // decoded. An offset that was recorded for a different location is dropped.
+  u32 GetOffset(const Location& location);
+
+  // Remembers that the first offset bytes of the block at location.read_ptr have been decoded.
+  void SetOffset(const Location& location, u32 offset);
+
+  void Reset() { m_offset = 0; }
+
+  // Decodes the size bytes at data, which are the FIFO data at location.read_ptr, starting at
+  // GetOffset(location). Returns the offset into data at which decoding stopped. If no command
+  // could be finished, this is the offset decoding started at.
+  u32 Decode(const Location& location, u8* data, u32 size, u32* cycles);
+
+private:
+  DecodeFunction m_decode;
+  Location m_location{};
+  u32 m_offset = 0;
+};
+}  // namespace Fifo
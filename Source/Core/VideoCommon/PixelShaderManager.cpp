@@ -197,6 +197,9 @@ void PixelShaderManager::SetConstants()
 void PixelShaderManager::SetTevColor(int index, int component, s32 value)
 {
   auto& c = constants.colors[index];
+  if (c[component] == value)
+    return;
+
   c[component] = value;
   dirty = true;
 
@@ -206,6 +209,9 @@ void PixelShaderManager::SetTevColor(int index, int component, s32 value)
 void PixelShaderManager::SetTevKonstColor(int index, int component, s32 value)
 {
   auto& c = constants.kcolors[index];
+  if (c[component] == value)
+    return;
+
   c[component] = value;
   dirty = true;
 
@@ -257,10 +263,16 @@ void PixelShaderManager::SetTevIndirectChanged()
 
 void PixelShaderManager::SetAlpha()
 {
-  constants.alpha[0] = bpmem.alpha_test.ref0;
-  constants.alpha[1] = bpmem.alpha_test.ref1;
-  constants.alpha[3] = static_cast<s32>(bpmem.dstalpha.alpha);
-  dirty = true;
+  const s32 ref0 = bpmem.alpha_test.ref0;
+  const s32 ref1 = bpmem.alpha_test.ref1;
+  const s32 dst_alpha = static_cast<s32>(bpmem.dstalpha.alpha);
+  if (constants.alpha[0] != ref0 || constants.alpha[1] != ref1 || constants.alpha[3] != dst_alpha)
+  {
+    constants.alpha[0] = ref0;
+    constants.alpha[1] = ref1;
+    constants.alpha[3] = dst_alpha;
+    dirty = true;
+  }
 }
 
 void PixelShaderManager::SetAlphaTestChanged()
@@ -299,8 +311,12 @@ void PixelShaderManager::SetTexDims(int texmapid, u32 width, u32 height)
 
 void PixelShaderManager::SetZTextureBias()
 {
-  constants.zbias[1][3] = bpmem.ztex1.bias;
-  dirty = true;
+  const s32 bias = static_cast<s32>(bpmem.ztex1.bias);
+  if (constants.zbias[1][3] != bias)
+  {
+    constants.zbias[1][3] = bias;
+    dirty = true;
+  }
 }
 
 void PixelShaderManager::SetViewportChanged()
@@ -312,17 +328,26 @@ void PixelShaderManager::SetViewportChanged()
 
 void PixelShaderManager::SetEfbScaleChanged(float scalex, float scaley)
 {
-  constants.efbscale[0] = 1.0f / scalex;
-  constants.efbscale[1] = 1.0f / scaley;
-  dirty = true;
+  const float efbscale_x = 1.0f / scalex;
+  const float efbscale_y = 1.0f / scaley;
+  if (constants.efbscale[0] != efbscale_x || constants.efbscale[1] != efbscale_y)
+  {
+    constants.efbscale[0] = efbscale_x;
+    constants.efbscale[1] = efbscale_y;
+    dirty = true;
+  }
 }
 
 void PixelShaderManager::SetZSlope(float dfdx, float dfdy, float f0)
 {
-  constants.zslope[0] = dfdx;
-  constants.zslope[1] = dfdy;
-  constants.zslope[2] = f0;
-  dirty = true;
+  // Set for every primitive when zfreeze is enabled, but usually with the same values.
+  if (constants.zslope[0] != dfdx || constants.zslope[1] != dfdy || constants.zslope[2] != f0)
+  {
+    constants.zslope[0] = dfdx;
+    constants.zslope[1] = dfdy;
+    constants.zslope[2] = f0;
+    dirty = true;
+  }
 }
 
 void PixelShaderManager::SetIndTexScaleChanged(bool high)
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -58,6 +59,7 @@
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/Benchmark.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/FPSCounter.h"
@@ -274,6 +276,14 @@ void Renderer::PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num
   }
 }
 
+bool Renderer::BBoxPollReadback(std::array<u16, 4>* values)
+{
+  for (size_t i = 0; i < values->size(); ++i)
+    (*values)[i] = BBoxRead(static_cast<int>(i));
+
+  return true;
+}
+
 void Renderer::RenderToXFB(u32 xfbAddr, const MathUtil::Rectangle<int>& sourceRc, u32 fbStride,
                            u32 fbHeight, float Gamma)
 {
@@ -1294,6 +1304,7 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         perf_sample.num_prims = g_stats.this_frame.num_prims + g_stats.this_frame.num_dl_prims;
         perf_sample.num_draw_calls = g_stats.this_frame.num_draw_calls;
         DolphinAnalytics::Instance().ReportPerformanceInfo(std::move(perf_sample));
+        Benchmark::OnGPUFrame();
 
         if (IsFrameDumping())
           DumpCurrentFrame(xfb_entry->texture.get(), xfb_rect, ticks, m_frame_count);
@@ -1472,9 +1483,6 @@ void Renderer::FlushFrameDump()
   if (!m_frame_dump_needs_flush)
     return;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
-
   std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
 
   // Queue encoding of the last frame dumped.
@@ -1484,10 +1492,12 @@ void Renderer::FlushFrameDump()
   {
     DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
                   output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
+    output->Unmap();
   }
   else
   {
     ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+    INCSTAT(g_stats.num_frame_dump_drops);
   }
 
   m_frame_dump_needs_flush = false;
@@ -1509,10 +1519,23 @@ void Renderer::ShutdownFrameDumping()
   FinishFrameData();
 
   // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+    m_frame_dump_thread_running.Clear();
+  }
+  m_frame_dump_queued.notify_one();
   if (m_frame_dump_thread.joinable())
     m_frame_dump_thread.join();
+
+  NOTICE_LOG_FMT(VIDEO, "Frame dump queue: {} frames at most, {} stalls, {} dropped frames",
+                 m_frame_dump_max_queue_depth, g_stats.num_frame_dump_stalls,
+                 g_stats.num_frame_dump_drops);
+  m_frame_dump_free_buffers.clear();
+  m_frame_dump_max_queue_depth = 0;
+  g_stats.frame_dump_queue_size = 0;
+  g_stats.frame_dump_queue_depth = 0;
+  g_stats.num_frame_dump_stalls = 0;
+  g_stats.num_frame_dump_drops = 0;
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
 
@@ -1522,8 +1545,6 @@ void Renderer::ShutdownFrameDumping()
 
 void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
 {
-  m_frame_dump_data = FrameDump::FrameData{data, w, h, stride, m_last_frame_state};
-
   if (!m_frame_dump_thread_running.IsSet())
   {
     if (m_frame_dump_thread.joinable())
@@ -1532,20 +1553,55 @@ void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
     m_frame_dump_thread = std::thread(&Renderer::FrameDumpThreadFunc, this);
   }
 
+  const size_t queue_size = static_cast<size_t>(std::max(g_ActiveConfig.iFrameDumpsQueueSize, 1));
+  QueuedFrameDumpFrame entry{{}, w, h, stride, m_last_frame_state};
+  {
+    std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+
+    // Only stall emulation if encoding has fallen behind by more than the whole queue, or drop
+    // the frame if stalling isn't wanted.
+    if (m_frame_dump_queue.size() >= queue_size)
+    {
+      if (g_ActiveConfig.bFrameDumpsDropWhenFull)
+      {
+        INCSTAT(g_stats.num_frame_dump_drops);
+        return;
+      }
+
+      INCSTAT(g_stats.num_frame_dump_stalls);
+      m_frame_dump_done.wait(lk, [&] { return m_frame_dump_queue.size() < queue_size; });
+    }
+
+    if (!m_frame_dump_free_buffers.empty())
+    {
+      entry.data = std::move(m_frame_dump_free_buffers.back());
+      m_frame_dump_free_buffers.pop_back();
+    }
+  }
+
+  // The dump thread can't use the mapped texture directly, as it has to be unmapped on this thread.
+  entry.data.resize(static_cast<size_t>(stride) * h);
+  std::memcpy(entry.data.data(), data, entry.data.size());
+
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+    m_frame_dump_queue.push_back(std::move(entry));
+
+    const u32 depth = static_cast<u32>(m_frame_dump_queue.size());
+    m_frame_dump_max_queue_depth = std::max(m_frame_dump_max_queue_depth, depth);
+    SETSTAT(g_stats.frame_dump_queue_depth, depth);
+    SETSTAT(g_stats.frame_dump_queue_size, queue_size);
+  }
+
   // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
+  m_frame_dump_queued.notify_one();
 }
 
 void Renderer::FinishFrameData()
 {
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
-
-  m_frame_dump_output_texture->Unmap();
+  std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+  m_frame_dump_done.wait(
+      lk, [&] { return m_frame_dump_queue.empty() && !m_frame_dump_frame_running; });
 }
 
 void Renderer::FrameDumpThreadFunc()
@@ -1567,11 +1623,23 @@ void Renderer::FrameDumpThreadFunc()
 
   while (true)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
+    QueuedFrameDumpFrame entry;
+    {
+      std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+      m_frame_dump_queued.wait(
+          lk, [&] { return !m_frame_dump_queue.empty() || !m_frame_dump_thread_running.IsSet(); });
 
-    auto frame = m_frame_dump_data;
+      // Frames still in the queue are encoded before exiting.
+      if (m_frame_dump_queue.empty())
+        break;
+
+      entry = std::move(m_frame_dump_queue.front());
+      m_frame_dump_queue.pop_front();
+      m_frame_dump_frame_running = true;
+    }
+
+    const FrameDump::FrameData frame{entry.data.data(), entry.width, entry.height, entry.stride,
+                                     entry.state};
 
     // Save screenshot
     if (m_screenshot_request.TestAndClear())
@@ -1610,7 +1678,12 @@ void Renderer::FrameDumpThreadFunc()
       }
     }
 
-    m_frame_dump_done.Set();
+    {
+      std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+      m_frame_dump_free_buffers.push_back(std::move(entry.data));
+      m_frame_dump_frame_running = false;
+    }
+    m_frame_dump_done.notify_all();
   }
 
   if (frame_dump_started)
@@ -15,6 +15,8 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -214,6 +216,11 @@ public:
   virtual u16 BBoxRead(int index) = 0;
   virtual void BBoxWrite(int index, u16 value) = 0;
   virtual void BBoxFlush() {}
+  // Deferred bounding box: starts copying the bounding box to the CPU without waiting for pending
+  // draws, and returns the values of the last copy which has completed. Backends without
+  // asynchronous readbacks read the values immediately.
+  virtual void BBoxRequestReadback() {}
+  virtual bool BBoxPollReadback(std::array<u16, 4>* values);
 
   virtual void Flush() {}
   virtual void WaitForGPUIdle() {}
@@ -355,18 +362,31 @@ private:
   std::thread m_frame_dump_thread;
   Common::Flag m_frame_dump_thread_running;
 
-  // Used to kick frame dump thread.
-  Common::Event m_frame_dump_start;
+  // Frame copied out of the readback texture, waiting to be encoded.
+  struct QueuedFrameDumpFrame
+  {
+    std::vector<u8> data;
+    int width;
+    int height;
+    int stride;
+    FrameDump::FrameState state;
+  };
 
-  // Set by frame dump thread on frame completion.
-  Common::Event m_frame_dump_done;
+  // Communication of frames between video and dump threads. The video thread only waits for the
+  // dump thread when the queue is full, so encoding may fall behind by that many frames.
+  std::mutex m_frame_dump_lock;
+  std::deque<QueuedFrameDumpFrame> m_frame_dump_queue;
+  // Buffers of frames which have been encoded, reused to avoid reallocating them for every frame.
+  std::vector<std::vector<u8>> m_frame_dump_free_buffers;
+  // Notified when a frame is queued, or the thread should exit.
+  std::condition_variable m_frame_dump_queued;
+  // Notified by the frame dump thread on frame completion.
+  std::condition_variable m_frame_dump_done;
+  u32 m_frame_dump_max_queue_depth = 0;
 
   // Holds emulation state during the last swap when dumping.
   FrameDump::FrameState m_last_frame_state;
 
-  // Communication of frame between video and dump threads.
-  FrameDump::FrameData m_frame_dump_data;
-
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
@@ -376,7 +396,7 @@ private:
   std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
   // Set when readback texture holds a frame that needs to be dumped.
   bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
+  // Set when thread is processing a frame taken from the queue. Guarded by m_frame_dump_lock.
   bool m_frame_dump_frame_running = false;
 
   // Used to generate screenshot names.
@@ -413,7 +433,7 @@ private:
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect, u64 ticks, int frame_number);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
+  // Copies the frame data to the queue of frames to encode, waiting if the queue is full.
   void DumpFrameData(const u8* data, int w, int h, int stride);
 
   // Ensures all rendered frames are queued for encoding.
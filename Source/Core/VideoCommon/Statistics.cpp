@@ -72,6 +72,7 @@ void Statistics::Display() const
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
+  draw_statistic("Draw calls avoided", "%d", this_frame.num_draw_calls_avoided);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
   draw_statistic("Primitives (DL)", "%d", this_frame.num_dl_prims);
   draw_statistic("XF loads", "%d", this_frame.num_xf_loads);
@@ -86,6 +87,26 @@ void Statistics::Display() const
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
+  draw_statistic("EFB cache hits:", "%d", this_frame.num_efb_cache_hits);
+  if (g_ActiveConfig.bEFBAccessOneFrameLate)
+    draw_statistic("EFB cache stale hits:", "%d", this_frame.num_efb_cache_stale_hits);
+  draw_statistic("EFB cache misses:", "%d", this_frame.num_efb_cache_misses);
+  if (g_ActiveConfig.bEFBAccessPrefetch || g_ActiveConfig.bEFBAccessOneFrameLate)
+    draw_statistic("EFB tiles prefetched:", "%d", this_frame.num_efb_cache_prefetches);
+  if (g_ActiveConfig.bBBoxDeferred)
+    draw_statistic("BBox readbacks:", "%d", this_frame.num_bbox_readbacks);
+  if (gpu_sync_distance != 0)
+  {
+    draw_statistic("GPU sync distance", "%d", gpu_sync_distance);
+    draw_statistic("GPU sync stalls", "%d", this_frame.num_gpu_sync_stalls);
+    draw_statistic("GPU sync stall time", "%d us", this_frame.gpu_sync_stall_us);
+  }
+  if (frame_dump_queue_size != 0)
+  {
+    draw_statistic("Frame dump queue", "%d/%d", frame_dump_queue_depth, frame_dump_queue_size);
+    draw_statistic("Frame dump stalls", "%d", num_frame_dump_stalls);
+    draw_statistic("Frame dump drops", "%d", num_frame_dump_drops);
+  }
 
   ImGui::Columns(1);
 
@@ -19,6 +19,15 @@ struct Statistics
 
   int num_vertex_loaders;
 
+  // Only set when adaptive GPU syncing is enabled.
+  int gpu_sync_distance;
+
+  // Only set while frames are being dumped.
+  int frame_dump_queue_size;
+  int frame_dump_queue_depth;
+  int num_frame_dump_stalls;
+  int num_frame_dump_drops;
+
   std::array<float, 6> proj;
   std::array<float, 16> gproj;
   std::array<float, 16> g2proj;
@@ -39,6 +48,7 @@ struct Statistics
 
     int num_primitive_joins;
     int num_draw_calls;
+    int num_draw_calls_avoided;
 
     int num_dlists_called;
 
@@ -59,6 +69,15 @@ struct Statistics
 
     int num_efb_peeks;
     int num_efb_pokes;
+    int num_efb_cache_hits;
+    int num_efb_cache_stale_hits;
+    int num_efb_cache_misses;
+    int num_efb_cache_prefetches;
+
+    int num_bbox_readbacks;
+
+    int num_gpu_sync_stalls;
+    int gpu_sync_stall_us;
   };
   ThisFrame this_frame;
   void ResetFrame();
@@ -4,6 +4,7 @@
 
 #include <cstring>
 #include <string>
+#include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/CPUDetect.h"
@@ -30,6 +31,37 @@ static const X64Reg base_reg = RBX;
 
 static const u8* memory_base_ptr = (u8*)&g_main_cp_state.array_strides;
 
+static const __m128i shuffle_lut[5][3] = {
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),   // 1x u8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),   // 2x u8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L)},  // 3x u8
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),   // 1x s8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),   // 2x s8
+     _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL)},  // 3x s8
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),   // 1x u16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),   // 2x u16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L)},  // 3x u16
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),   // 1x s16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),   // 2x s16
+     _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL)},  // 3x s16
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x float
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x float
+     _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x float
+};
+static const __m128 scale_factors[32] = {
+    _mm_set_ps1(1. / (1u << 0)),  _mm_set_ps1(1. / (1u << 1)),  _mm_set_ps1(1. / (1u << 2)),
+    _mm_set_ps1(1. / (1u << 3)),  _mm_set_ps1(1. / (1u << 4)),  _mm_set_ps1(1. / (1u << 5)),
+    _mm_set_ps1(1. / (1u << 6)),  _mm_set_ps1(1. / (1u << 7)),  _mm_set_ps1(1. / (1u << 8)),
+    _mm_set_ps1(1. / (1u << 9)),  _mm_set_ps1(1. / (1u << 10)), _mm_set_ps1(1. / (1u << 11)),
+    _mm_set_ps1(1. / (1u << 12)), _mm_set_ps1(1. / (1u << 13)), _mm_set_ps1(1. / (1u << 14)),
+    _mm_set_ps1(1. / (1u << 15)), _mm_set_ps1(1. / (1u << 16)), _mm_set_ps1(1. / (1u << 17)),
+    _mm_set_ps1(1. / (1u << 18)), _mm_set_ps1(1. / (1u << 19)), _mm_set_ps1(1. / (1u << 20)),
+    _mm_set_ps1(1. / (1u << 21)), _mm_set_ps1(1. / (1u << 22)), _mm_set_ps1(1. / (1u << 23)),
+    _mm_set_ps1(1. / (1u << 24)), _mm_set_ps1(1. / (1u << 25)), _mm_set_ps1(1. / (1u << 26)),
+    _mm_set_ps1(1. / (1u << 27)), _mm_set_ps1(1. / (1u << 28)), _mm_set_ps1(1. / (1u << 29)),
+    _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
+};
+
 static OpArg MPIC(const void* ptr, X64Reg scale_reg, int scale = SCALE_1)
 {
   return MComplex(base_reg, scale_reg, scale, PtrOffset(ptr, memory_base_ptr));
@@ -46,7 +78,7 @@ VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
   if (!IsInitialized())
     return;
 
-  AllocCodeSpace(4096);
+  AllocCodeSpace(8192);
   ClearCodeSpace();
   GenerateVertexLoader();
   WriteProtect();
@@ -82,37 +114,6 @@ int VertexLoaderX64::ReadVertex(OpArg data, u64 attribute, int format, int count
                                 bool dequantize, u8 scaling_exponent,
                                 AttributeFormat* native_format)
 {
-  static const __m128i shuffle_lut[5][3] = {
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),   // 1x u8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),   // 2x u8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L)},  // 3x u8
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),   // 1x s8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),   // 2x s8
-       _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL)},  // 3x s8
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),   // 1x u16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),   // 2x u16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L)},  // 3x u16
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),   // 1x s16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),   // 2x s16
-       _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL)},  // 3x s16
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x float
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x float
-       _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x float
-  };
-  static const __m128 scale_factors[32] = {
-      _mm_set_ps1(1. / (1u << 0)),  _mm_set_ps1(1. / (1u << 1)),  _mm_set_ps1(1. / (1u << 2)),
-      _mm_set_ps1(1. / (1u << 3)),  _mm_set_ps1(1. / (1u << 4)),  _mm_set_ps1(1. / (1u << 5)),
-      _mm_set_ps1(1. / (1u << 6)),  _mm_set_ps1(1. / (1u << 7)),  _mm_set_ps1(1. / (1u << 8)),
-      _mm_set_ps1(1. / (1u << 9)),  _mm_set_ps1(1. / (1u << 10)), _mm_set_ps1(1. / (1u << 11)),
-      _mm_set_ps1(1. / (1u << 12)), _mm_set_ps1(1. / (1u << 13)), _mm_set_ps1(1. / (1u << 14)),
-      _mm_set_ps1(1. / (1u << 15)), _mm_set_ps1(1. / (1u << 16)), _mm_set_ps1(1. / (1u << 17)),
-      _mm_set_ps1(1. / (1u << 18)), _mm_set_ps1(1. / (1u << 19)), _mm_set_ps1(1. / (1u << 20)),
-      _mm_set_ps1(1. / (1u << 21)), _mm_set_ps1(1. / (1u << 22)), _mm_set_ps1(1. / (1u << 23)),
-      _mm_set_ps1(1. / (1u << 24)), _mm_set_ps1(1. / (1u << 25)), _mm_set_ps1(1. / (1u << 26)),
-      _mm_set_ps1(1. / (1u << 27)), _mm_set_ps1(1. / (1u << 28)), _mm_set_ps1(1. / (1u << 29)),
-      _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
-  };
-
   X64Reg coords = XMM0;
 
   int elem_size = 1 << (format / 2);
@@ -384,28 +385,8 @@ void VertexLoaderX64::ReadColor(OpArg data, u64 attribute, int format)
     m_src_ofs += load_bytes;
 }
 
-void VertexLoaderX64::GenerateVertexLoader()
+void VertexLoaderX64::GenerateVertex()
 {
-  BitSet32 regs = {src_reg,  dst_reg,   scratch1,    scratch2,
-                   scratch3, count_reg, skipped_reg, base_reg};
-  regs &= ABI_ALL_CALLEE_SAVED;
-  ABI_PushRegistersAndAdjustStack(regs, 0);
-
-  // Backup count since we're going to count it down.
-  PUSH(32, R(ABI_PARAM3));
-
-  // ABI_PARAM3 is one of the lower registers, so free it for scratch2.
-  MOV(32, R(count_reg), R(ABI_PARAM3));
-
-  MOV(64, R(base_reg), R(ABI_PARAM4));
-
-  if (m_VtxDesc.Position & MASK_INDEXED)
-    XOR(32, R(skipped_reg), R(skipped_reg));
-
-  // TODO: load constants into registers outside the main loop
-
-  const u8* loop_start = GetCodePtr();
-
   if (m_VtxDesc.PosMatIdx)
   {
     MOVZX(32, 8, scratch1, MDisp(src_reg, m_src_ofs));
@@ -523,14 +504,333 @@ void VertexLoaderX64::GenerateVertexLoader()
       }
     }
   }
+}
+
+VertexLoaderX64::PairedVertexAddr VertexLoaderX64::GetPairedVertexAddr(int array,
+                                                                       u64 attribute)
+{
+  PairedVertexAddr addr{array, attribute, m_src_ofs, 0};
+  if (attribute & MASK_INDEXED)
+    m_src_ofs += attribute == INDEX8 ? 1 : 2;
+  return addr;
+}
+
+OpArg VertexLoaderX64::GetPairedVertexData(const PairedVertexAddr& addr, int vertex)
+{
+  const u32 src_ofs = addr.src_ofs + vertex * m_VertexSize;
+  if (addr.attribute & MASK_INDEXED)
+  {
+    LoadAndSwap(addr.attribute == INDEX8 ? 8 : 16, scratch1, MDisp(src_reg, src_ofs));
+    IMUL(32, scratch1, MPIC(&g_main_cp_state.array_strides[addr.array]));
+    MOV(64, R(scratch2), MPIC(&VertexLoaderManager::cached_arraybases[addr.array]));
+    OpArg data = MRegSum(scratch1, scratch2);
+    data.AddMemOffset(addr.disp);
+    return data;
+  }
+  else
+  {
+    return MDisp(src_reg, src_ofs + addr.disp);
+  }
+}
+
+int VertexLoaderX64::ReadVertexPair(const PairedVertexAddr& addr, int format, int count_in,
+                                    int count_out, bool dequantize, u8 scaling_exponent,
+                                    bool is_position)
+{
+  // Both vertices are loaded into the two 128-bit lanes of ymm0, so they can share the byte
+  // swapping, sign extension, conversion and dequantization.
+  const X64Reg coords = XMM0;
+  const X64Reg coords_b = XMM1;
+  const X64Reg temp = XMM2;
+  const u32 stride = m_native_vtx_decl.stride;
+
+  const int elem_size = 1 << (format / 2);
+  const int load_bytes = elem_size * count_in;
+
+  for (int i = 0; i < 2; i++)
+  {
+    const X64Reg reg = i ? coords_b : coords;
+    const OpArg data = GetPairedVertexData(addr, i);
+    if (load_bytes > 8)
+      VMOVDQU(reg, data);
+    else if (load_bytes > 4)
+      VMOVQ_xmm(reg, data);
+    else
+      VMOVD_xmm(reg, data);
+  }
+
+  VINSERTI128(coords, coords, R(coords_b), 1);
+  VBROADCASTI128(temp, MPIC(&shuffle_lut[format][count_in - 1]));
+  VPSHUFB(256, coords, coords, R(temp));
+
+  // Sign-extend.
+  if (format == FORMAT_BYTE)
+    VPSRAD(256, coords, coords, 24);
+  if (format == FORMAT_SHORT)
+    VPSRAD(256, coords, coords, 16);
+
+  if (format != FORMAT_FLOAT)
+  {
+    VCVTDQ2PS(256, coords, R(coords));
+
+    if (dequantize && scaling_exponent)
+    {
+      VBROADCASTSS(256, temp, MPIC(&scale_factors[scaling_exponent]));
+      VMULPS(256, coords, coords, R(temp));
+    }
+  }
+
+  VEXTRACTI128(R(coords_b), coords, 1);
+
+  for (int i = 0; i < 2; i++)
+  {
+    const X64Reg reg = i ? coords_b : coords;
+    const OpArg dest = MDisp(dst_reg, m_dst_ofs + i * stride);
+    switch (count_out)
+    {
+    case 1:
+      VMOVSS(dest, reg);
+      break;
+    case 2:
+      VMOVLPS(dest, reg);
+      break;
+    case 3:
+      // Unlike in GenerateVertex, the store must not spill into the following attribute, as
+      // that might be the position matrix index of the second vertex, which is already written.
+      VMOVLPS(dest, reg);
+      VMOVHLPS(temp, reg, reg);
+      VMOVSS(MDisp(dst_reg, m_dst_ofs + i * stride + 8), temp);
+      break;
+    }
+
+    // zfreeze
+    if (is_position)
+    {
+      CMP(32, R(count_reg), Imm8(3 + i));
+      FixupBranch dont_store = J_CC(CC_A);
+      LEA(32, scratch3, MScaled(count_reg, SCALE_4, -4 - 4 * i));
+      VMOVUPS(MPIC(VertexLoaderManager::position_cache, scratch3, SCALE_4), reg);
+      SetJumpTarget(dont_store);
+    }
+  }
+
+  m_dst_ofs += sizeof(float) * count_out;
+
+  if (addr.attribute == DIRECT)
+    m_src_ofs += load_bytes;
+
+  return load_bytes;
+}
+
+void VertexLoaderX64::GenerateVertexPair()
+{
+  // This mirrors GenerateVertex, but loads two consecutive vertices per iteration. The vertex
+  // layout is already known at this point, so the offsets can be checked against it.
+  const u32 vertex_size = m_VertexSize;
+  const u32 stride = m_native_vtx_decl.stride;
+  m_src_ofs = 0;
+  m_dst_ofs = 0;
+
+  if (m_VtxDesc.PosMatIdx)
+  {
+    for (int i = 0; i < 2; i++)
+    {
+      MOVZX(32, 8, scratch1, MDisp(src_reg, m_src_ofs + i * vertex_size));
+      AND(32, R(scratch1), Imm8(0x3F));
+      MOV(32, MDisp(dst_reg, m_dst_ofs + i * stride), R(scratch1));
+
+      // zfreeze
+      CMP(32, R(count_reg), Imm8(3 + i));
+      FixupBranch dont_store = J_CC(CC_A);
+      MOV(32, MPIC(VertexLoaderManager::position_matrix_index - i, count_reg, SCALE_4),
+          R(scratch1));
+      SetJumpTarget(dont_store);
+    }
+    m_src_ofs += sizeof(u8);
+    m_dst_ofs += sizeof(u32);
+  }
+
+  u32 texmatidx_ofs[8];
+  const u64 tm[8] = {
+      m_VtxDesc.Tex0MatIdx, m_VtxDesc.Tex1MatIdx, m_VtxDesc.Tex2MatIdx, m_VtxDesc.Tex3MatIdx,
+      m_VtxDesc.Tex4MatIdx, m_VtxDesc.Tex5MatIdx, m_VtxDesc.Tex6MatIdx, m_VtxDesc.Tex7MatIdx,
+  };
+  for (int i = 0; i < 8; i++)
+  {
+    if (tm[i])
+      texmatidx_ofs[i] = m_src_ofs++;
+  }
+
+  PairedVertexAddr addr = GetPairedVertexAddr(ARRAY_POSITION, m_VtxDesc.Position);
+  int pos_elements = 2 + m_VtxAttr.PosElements;
+  ReadVertexPair(addr, m_VtxAttr.PosFormat, pos_elements, pos_elements, m_VtxAttr.ByteDequant,
+                 m_VtxAttr.PosFrac, true);
+
+  if (m_VtxDesc.Normal)
+  {
+    static const u8 map[8] = {7, 6, 15, 14};
+    u8 scaling_exponent = map[m_VtxAttr.NormalFormat];
+
+    for (int i = 0; i < (m_VtxAttr.NormalElements ? 3 : 1); i++)
+    {
+      if (!i || m_VtxAttr.NormalIndex3)
+      {
+        addr = GetPairedVertexAddr(ARRAY_NORMAL, m_VtxDesc.Normal);
+        int elem_size = 1 << (m_VtxAttr.NormalFormat / 2);
+        addr.disp += i * elem_size * 3;
+      }
+      addr.disp +=
+          ReadVertexPair(addr, m_VtxAttr.NormalFormat, 3, 3, true, scaling_exponent, false);
+    }
+  }
+
+  const u64 col[2] = {m_VtxDesc.Color0, m_VtxDesc.Color1};
+  for (int i = 0; i < 2; i++)
+  {
+    if (col[i])
+    {
+      addr = GetPairedVertexAddr(ARRAY_COLOR + i, col[i]);
+      const u32 src_ofs = m_src_ofs;
+      for (int j = 0; j < 2; j++)
+      {
+        // ReadColor only advances m_src_ofs for direct colors, which are already accounted for by
+        // the data address of the second vertex.
+        m_src_ofs = src_ofs;
+        m_dst_ofs += j * stride;
+        ReadColor(GetPairedVertexData(addr, j), col[i], m_VtxAttr.color[i].Comp);
+        m_dst_ofs -= j * stride;
+      }
+      m_dst_ofs += 4;
+    }
+  }
+
+  const u64 tc[8] = {
+      m_VtxDesc.Tex0Coord, m_VtxDesc.Tex1Coord, m_VtxDesc.Tex2Coord, m_VtxDesc.Tex3Coord,
+      m_VtxDesc.Tex4Coord, m_VtxDesc.Tex5Coord, m_VtxDesc.Tex6Coord, m_VtxDesc.Tex7Coord,
+  };
+  for (int i = 0; i < 8; i++)
+  {
+    int elements = m_VtxAttr.texCoord[i].Elements + 1;
+    if (tc[i])
+    {
+      addr = GetPairedVertexAddr(ARRAY_TEXCOORD0 + i, tc[i]);
+      u8 scaling_exponent = m_VtxAttr.texCoord[i].Frac;
+      ReadVertexPair(addr, m_VtxAttr.texCoord[i].Format, elements, tm[i] ? 2 : elements,
+                     m_VtxAttr.ByteDequant, scaling_exponent, false);
+    }
+    if (tm[i])
+    {
+      for (int j = 0; j < 2; j++)
+      {
+        MOVZX(64, 8, scratch1, MDisp(src_reg, texmatidx_ofs[i] + j * vertex_size));
+        if (tc[i])
+        {
+          VCVTSI2SS(32, XMM0, XMM0, R(scratch1));
+          VMOVSS(MDisp(dst_reg, m_dst_ofs + j * stride), XMM0);
+        }
+        else
+        {
+          // Stores (0, 0, X) with exact-width stores, see ReadVertexPair.
+          VCVTSI2SS(32, XMM0, XMM0, R(scratch1));
+          MOV(64, MDisp(dst_reg, m_dst_ofs + j * stride), Imm32(0));
+          VMOVSS(MDisp(dst_reg, m_dst_ofs + j * stride + 8), XMM0);
+        }
+      }
+      m_dst_ofs += sizeof(float) * (tc[i] ? 1 : 3);
+    }
+  }
+
+  ASSERT(m_src_ofs == vertex_size && m_dst_ofs == stride);
+}
+
+void VertexLoaderX64::GenerateVertexLoader()
+{
+  BitSet32 regs = {src_reg,  dst_reg,   scratch1,    scratch2,
+                   scratch3, count_reg, skipped_reg, base_reg};
+  regs &= ABI_ALL_CALLEE_SAVED;
+  ABI_PushRegistersAndAdjustStack(regs, 0);
+
+  // Backup count since we're going to count it down.
+  PUSH(32, R(ABI_PARAM3));
+
+  // ABI_PARAM3 is one of the lower registers, so free it for scratch2.
+  MOV(32, R(count_reg), R(ABI_PARAM3));
+
+  MOV(64, R(base_reg), R(ABI_PARAM4));
+
+  if (m_VtxDesc.Position & MASK_INDEXED)
+    XOR(32, R(skipped_reg), R(skipped_reg));
+
+  // With AVX2, the main loop processes two vertices at once, and the single vertex loop is only
+  // used for the last vertex and for vertices which have to be skipped.
+  const bool paired = cpu_info.bAVX2;
+  FixupBranch to_paired_loop;
+  if (paired)
+    to_paired_loop = J(true);
+
+  // TODO: load constants into registers outside the main loop
+
+  const u8* loop_start = GetCodePtr();
+
+  GenerateVertex();
 
   // Prepare for the next vertex.
   ADD(64, R(dst_reg), Imm32(m_dst_ofs));
   const u8* cont = GetCodePtr();
   ADD(64, R(src_reg), Imm32(m_src_ofs));
 
+  m_VertexSize = m_src_ofs;
+  m_native_vtx_decl.stride = m_dst_ofs;
+
   SUB(32, R(count_reg), Imm8(1));
-  J_CC(CC_NZ, loop_start);
+  if (paired)
+  {
+    FixupBranch done = J_CC(CC_Z, true);
+
+    SetJumpTarget(to_paired_loop);
+    const u8* paired_loop_start = GetCodePtr();
+    std::vector<FixupBranch> to_single_loop;
+    CMP(32, R(count_reg), Imm8(2));
+    to_single_loop.push_back(J_CC(CC_B, true));
+    if (m_VtxDesc.Position & MASK_INDEXED)
+    {
+      // Let the single vertex loop deal with skipped vertices.
+      const int bits = m_VtxDesc.Position == INDEX8 ? 8 : 16;
+      const u32 index_ofs = m_VtxDesc.PosMatIdx + m_VtxDesc.Tex0MatIdx + m_VtxDesc.Tex1MatIdx +
+                            m_VtxDesc.Tex2MatIdx + m_VtxDesc.Tex3MatIdx + m_VtxDesc.Tex4MatIdx +
+                            m_VtxDesc.Tex5MatIdx + m_VtxDesc.Tex6MatIdx + m_VtxDesc.Tex7MatIdx;
+      for (int i = 0; i < 2; i++)
+      {
+        CMP(bits, MDisp(src_reg, index_ofs + i * m_VertexSize), Imm8(-1));
+        to_single_loop.push_back(J_CC(CC_E, true));
+      }
+    }
+
+    GenerateVertexPair();
+
+    ADD(64, R(dst_reg), Imm32(2 * m_dst_ofs));
+    ADD(64, R(src_reg), Imm32(2 * m_src_ofs));
+    SUB(32, R(count_reg), Imm8(2));
+    J_CC(CC_NZ, paired_loop_start);
+
+    // The paired loop only uses VEX-encoded instructions, so the upper halves of the ymm registers
+    // only have to be cleared once when leaving it, to avoid the AVX-SSE transition penalty in the
+    // single vertex loop and in the caller.
+    VZEROUPPER();
+    FixupBranch paired_done = J(true);
+
+    for (FixupBranch& branch : to_single_loop)
+      SetJumpTarget(branch);
+    VZEROUPPER();
+    JMP(loop_start, true);
+
+    SetJumpTarget(done);
+    SetJumpTarget(paired_done);
+  }
+  else
+  {
+    J_CC(CC_NZ, loop_start);
+  }
 
   // Get the original count.
   POP(32, R(ABI_RETURN));
@@ -544,15 +844,12 @@ void VertexLoaderX64::GenerateVertexLoader()
 
     SetJumpTarget(m_skip_vertex);
     ADD(32, R(skipped_reg), Imm8(1));
-    JMP(cont);
+    JMP(cont, true);
   }
   else
   {
     RET();
   }
-
-  m_VertexSize = m_src_ofs;
-  m_native_vtx_decl.stride = m_dst_ofs;
 }
 
 int VertexLoaderX64::RunVertices(DataReader src, DataReader dst, int count)
@@ -19,6 +19,16 @@ protected:
   int RunVertices(DataReader src, DataReader dst, int count) override;
 
 private:
+  // The source of an attribute in the paired (AVX2) loop, which is resolved separately for each of
+  // the two vertices.
+  struct PairedVertexAddr
+  {
+    int array;
+    u64 attribute;
+    u32 src_ofs;
+    s32 disp;
+  };
+
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
   Gen::FixupBranch m_skip_vertex;
@@ -26,5 +36,11 @@ private:
   int ReadVertex(Gen::OpArg data, u64 attribute, int format, int count_in, int count_out,
                  bool dequantize, u8 scaling_exponent, AttributeFormat* native_format);
   void ReadColor(Gen::OpArg data, u64 attribute, int format);
+  PairedVertexAddr GetPairedVertexAddr(int array, u64 attribute);
+  Gen::OpArg GetPairedVertexData(const PairedVertexAddr& addr, int vertex);
+  int ReadVertexPair(const PairedVertexAddr& addr, int format, int count_in, int count_out,
+                     bool dequantize, u8 scaling_exponent, bool is_position);
+  void GenerateVertex();
+  void GenerateVertexPair();
   void GenerateVertexLoader();
 };
@@ -4,9 +4,11 @@
 
 #include "VideoCommon/VertexManagerBase.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <memory>
+#include <utility>
 
 #include "Common/BitSet.h"
 #include "Common/ChunkFile.h"
@@ -160,6 +162,7 @@ DataReader VertexManagerBase::PrepareForAdditionalData(int primitive, u32 count,
   }
 
   m_cull_all = cullall;
+  m_flush_avoided = false;
 
   // need to alloc new buffer
   if (m_is_flushed)
@@ -354,12 +357,24 @@ void VertexManagerBase::LoadTextures()
   g_texture_cache->BindTextures();
 }
 
+void VertexManagerBase::OnFlushAvoided()
+{
+  // Otherwise, the pending draw would have been split in two. Further state changes before the
+  // next primitive would have found the vertex manager flushed already, so they don't count.
+  if (!m_is_flushed && !m_flush_avoided)
+  {
+    INCSTAT(g_stats.this_frame.num_draw_calls_avoided);
+    m_flush_avoided = true;
+  }
+}
+
 void VertexManagerBase::Flush()
 {
   if (m_is_flushed)
     return;
 
   m_is_flushed = true;
+  m_flush_avoided = false;
 
   if (xfmem.numTexGen.numTexGens != bpmem.genMode.numtexgens ||
       xfmem.numChan.numColorChans != bpmem.genMode.numcolchans)
@@ -504,6 +519,14 @@ void VertexManagerBase::Flush()
 
       // The EFB cache is now potentially stale.
       g_framebuffer_manager->FlagPeekCacheAsOutOfDate();
+
+      // If the CPU missed the EFB cache after this draw last frame, start reading back the tiles
+      // it accessed now, so that they are ready or nearly ready by the time they are needed.
+      if (std::binary_search(m_scheduled_efb_prefetches.begin(), m_scheduled_efb_prefetches.end(),
+                             m_draw_counter))
+      {
+        g_framebuffer_manager->PrefetchEFBCache();
+      }
     }
   }
 
@@ -754,6 +777,17 @@ void VertexManagerBase::OnCPUEFBAccess()
   m_cpu_accesses_this_frame.emplace_back(m_draw_counter);
 }
 
+void VertexManagerBase::OnEFBCacheMiss()
+{
+  if (!m_efb_cache_misses_this_frame.empty() &&
+      m_efb_cache_misses_this_frame.back() == m_draw_counter)
+  {
+    return;
+  }
+
+  m_efb_cache_misses_this_frame.emplace_back(m_draw_counter);
+}
+
 void VertexManagerBase::OnEFBCopyToRAM()
 {
   // If we're not deferring, try to preempt it next frame.
@@ -778,6 +812,14 @@ void VertexManagerBase::OnEndFrame()
   m_last_efb_copy_draw_counter = 0;
   m_scheduled_command_buffer_kicks.clear();
 
+  // Prefetch the EFB tiles at the same points as the cache misses happened in this frame. One frame
+  // late accesses rely on this to refresh the stale tiles they return, so they always prefetch.
+  m_scheduled_efb_prefetches.clear();
+  if (g_ActiveConfig.bEFBAccessPrefetch || g_ActiveConfig.bEFBAccessOneFrameLate)
+    std::swap(m_scheduled_efb_prefetches, m_efb_cache_misses_this_frame);
+  m_efb_cache_misses_this_frame.clear();
+  g_framebuffer_manager->OnEndFrame();
+
   // If we have no CPU access at all, leave everything in the one command buffer for maximum
   // parallelism between CPU/GPU, at the cost of slightly higher latency.
   if (m_cpu_accesses_this_frame.empty())
@@ -99,6 +99,8 @@ public:
   void FlushData(u32 count, u32 stride);
 
   void Flush();
+  // Called instead of Flush() for state changes which turned out not to affect pending draws.
+  void OnFlushAvoided();
 
   void DoState(PointerWrap& p);
 
@@ -140,6 +142,9 @@ public:
   // Call after CPU access is requested.
   void OnCPUEFBAccess();
 
+  // Call when a CPU access did not find the requested EFB tile in the peek cache.
+  void OnEFBCacheMiss();
+
   // Call after an EFB copy to RAM. If true, the current command buffer should be executed.
   void OnEFBCopyToRAM();
 
@@ -199,6 +204,8 @@ private:
   void UpdatePipelineObject();
 
   bool m_is_flushed = true;
+  // Whether a flush was avoided since the last primitive was added.
+  bool m_flush_avoided = false;
   FlushStatistics m_flush_statistics = {};
 
   // CPU access tracking
@@ -206,6 +213,8 @@ private:
   u32 m_last_efb_copy_draw_counter = 0;
   std::vector<u32> m_cpu_accesses_this_frame;
   std::vector<u32> m_scheduled_command_buffer_kicks;
+  std::vector<u32> m_efb_cache_misses_this_frame;
+  std::vector<u32> m_scheduled_efb_prefetches;
   bool m_allow_background_execution = true;
 };
 
@@ -39,6 +39,7 @@
 
 #include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BPStructs.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/Fifo.h"
@@ -185,11 +186,21 @@ u16 VideoBackendBase::Video_GetBoundingBox(int index)
     return 0;
   }
 
+  AsyncRequests::Event e;
+  e.time = 0;
+
+  // Return the last completed readback, and start a new one without waiting for the GPU thread to
+  // process the draws which came before this read.
+  if (g_ActiveConfig.bBBoxDeferred)
+  {
+    e.type = AsyncRequests::Event::BBOX_READBACK;
+    AsyncRequests::GetInstance()->PushEvent(e);
+    return BoundingBox::GetReadbackCoordinate(static_cast<BoundingBox::Coordinate>(index));
+  }
+
   Fifo::SyncGPU(Fifo::SyncGPUReason::BBox);
 
-  AsyncRequests::Event e;
   u16 result;
-  e.time = 0;
   e.type = AsyncRequests::Event::BBOX_READ;
   e.bbox.index = index;
   e.bbox.data = &result;
@@ -111,12 +111,20 @@ struct VideoConfig final
   bool bBorderlessFullscreen;
   bool bEnableGPUTextureDecoding;
   int iBitrateKbps;
+  // Number of frames which may wait for encoding before emulation is stalled.
+  int iFrameDumpsQueueSize;
+  // Threads used for color conversion and encoding of frame dumps, 0 for automatic.
+  int iFrameDumpsThreads;
+  // Drop frames instead of stalling emulation when the frame dump queue is full.
+  bool bFrameDumpsDropWhenFull;
 
   // Hacks
   bool bEFBAccessEnable;
   bool bEFBAccessDeferInvalidation;
   bool bPerfQueriesEnable;
   bool bBBoxEnable;
+  // Return the last bounding box read back from the GPU instead of waiting for pending draws.
+  bool bBBoxDeferred;
   bool bForceProgressive;
 
   bool bEFBEmulateFormatChanges;
@@ -133,6 +141,8 @@ struct VideoConfig final
   bool bFastDepthCalc;
   bool bVertexRounding;
   int iEFBAccessTileSize;
+  bool bEFBAccessPrefetch;
+  bool bEFBAccessOneFrameLate;
   int iLog;           // CONF_ bits
   int iSaveTargetId;  // TODO: Should be dropped
 
@@ -156,6 +166,7 @@ struct VideoConfig final
   bool bDumpObjects;
   bool bDumpTevStages;
   bool bDumpTevTextureFetches;
+  int iSWRasterizerThreads;
 
   // Enable API validation layers, currently only supported with Vulkan.
   bool bEnableValidationLayer;
@@ -241,6 +252,7 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetSWRasterizerThreads() const;
 };
 
 extern VideoConfig g_Config;
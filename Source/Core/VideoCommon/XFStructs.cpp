@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
@@ -23,6 +25,18 @@ static void XFMemWritten(u32 transferSize, u32 baseAddress)
   VertexShaderManager::InvalidateXFRange(baseAddress, baseAddress + transferSize);
 }
 
+// Returns true if any of the count words of xfmem at address differ from the ones at src.
+static bool XFDataChanged(u32 address, u32 count, const DataReader& src, u32 dataIndex)
+{
+  const u32* current = reinterpret_cast<const u32*>(&xfmem) + address;
+  for (u32 i = 0; i < count; i++)
+  {
+    if (current[i] != src.Peek<u32>(static_cast<int>((dataIndex + i) * sizeof(u32))))
+      return true;
+  }
+  return false;
+}
+
 static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
 {
   u32 address = baseAddress;
@@ -111,12 +125,18 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETVIEWPORT + 3:
     case XFMEM_SETVIEWPORT + 4:
     case XFMEM_SETVIEWPORT + 5:
+      nextAddress = XFMEM_SETVIEWPORT + 6;
+      if (!XFDataChanged(address, std::min<u32>(nextAddress - address, transferSize), src,
+                         dataIndex))
+      {
+        g_vertex_manager->OnFlushAvoided();
+        break;
+      }
+
       g_vertex_manager->Flush();
       VertexShaderManager::SetViewportChanged();
       PixelShaderManager::SetViewportChanged();
       GeometryShaderManager::SetViewportChanged();
-
-      nextAddress = XFMEM_SETVIEWPORT + 6;
       break;
 
     case XFMEM_SETPROJECTION:
@@ -126,11 +146,17 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPROJECTION + 4:
     case XFMEM_SETPROJECTION + 5:
     case XFMEM_SETPROJECTION + 6:
+      nextAddress = XFMEM_SETPROJECTION + 7;
+      if (!XFDataChanged(address, std::min<u32>(nextAddress - address, transferSize), src,
+                         dataIndex))
+      {
+        g_vertex_manager->OnFlushAvoided();
+        break;
+      }
+
       g_vertex_manager->Flush();
       VertexShaderManager::SetProjectionChanged();
       GeometryShaderManager::SetProjectionChanged();
-
-      nextAddress = XFMEM_SETPROJECTION + 7;
       break;
 
     case XFMEM_SETNUMTEXGENS:  // GXSetNumTexGens
@@ -146,10 +172,16 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETTEXMTXINFO + 5:
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
+      nextAddress = XFMEM_SETTEXMTXINFO + 8;
+      if (!XFDataChanged(address, std::min<u32>(nextAddress - address, transferSize), src,
+                         dataIndex))
+      {
+        g_vertex_manager->OnFlushAvoided();
+        break;
+      }
+
       g_vertex_manager->Flush();
       VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
-
-      nextAddress = XFMEM_SETTEXMTXINFO + 8;
       break;
 
     case XFMEM_SETPOSTMTXINFO:
@@ -160,10 +192,16 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPOSTMTXINFO + 5:
     case XFMEM_SETPOSTMTXINFO + 6:
     case XFMEM_SETPOSTMTXINFO + 7:
+      nextAddress = XFMEM_SETPOSTMTXINFO + 8;
+      if (!XFDataChanged(address, std::min<u32>(nextAddress - address, transferSize), src,
+                         dataIndex))
+      {
+        g_vertex_manager->OnFlushAvoided();
+        break;
+      }
+
       g_vertex_manager->Flush();
       VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
-
-      nextAddress = XFMEM_SETPOSTMTXINFO + 8;
       break;
 
     // --------------
@@ -235,7 +273,11 @@ void LoadXFReg(u32 transferSize, u32 baseAddress, DataReader src)
       transferSize = 0;
     }
 
-    XFMemWritten(xfMemTransferSize, xfMemBase);
+    // Games commonly reload unchanged matrices, which would otherwise split the current batch.
+    if (XFDataChanged(xfMemBase, xfMemTransferSize, src, 0))
+      XFMemWritten(xfMemTransferSize, xfMemBase);
+    else
+      g_vertex_manager->OnFlushAvoided();
     for (u32 i = 0; i < xfMemTransferSize; i++)
     {
       ((u32*)&xfmem)[xfMemBase + i] = src.Read<u32>();
@@ -0,0 +1,108 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/Mixer.h"
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+
+namespace
+{
+using Buffer = std::array<short, Mixer::MAX_SAMPLES * 2>;
+
+// The scalar tap loop the resampler falls back to where the filter wraps around the buffer.
+void ReferenceApplyResampler(const Buffer& buffer, u32 first, const Mixer::ResamplerPhase& phase,
+                             int* left, int* right)
+{
+  *left = 0;
+  *right = 0;
+  for (u32 i = 0; i < Mixer::RESAMPLER_TAPS; ++i)
+  {
+    const s16 sample_left = Common::swap16(buffer[(first + i * 2) & Mixer::INDEX_MASK]);
+    const s16 sample_right = Common::swap16(buffer[(first + i * 2 + 1) & Mixer::INDEX_MASK]);
+    *left += sample_left * phase.taps[i];
+    *right += sample_right * phase.taps[i];
+  }
+}
+
+Buffer MakeBuffer(std::mt19937& rng)
+{
+  Buffer buffer;
+  std::uniform_int_distribution<int> distribution(-32768, 32767);
+  for (short& sample : buffer)
+    sample = Common::swap16(static_cast<u16>(distribution(rng)));
+  // Make sure that full-scale input, where the filter overshoots, is covered.
+  for (size_t i = 0; i < 64; ++i)
+    buffer[i] = Common::swap16(static_cast<u16>((i / 2) % 2 ? 32767 : -32768));
+  return buffer;
+}
+}  // namespace
+
+TEST(Mixer, ResamplerPhasesHaveUnityGain)
+{
+  for (const Mixer::ResamplerPhase& phase : Mixer::GetResamplerFilter())
+  {
+    int sum = 0;
+    for (u32 i = 0; i < Mixer::RESAMPLER_TAPS; ++i)
+    {
+      sum += phase.taps[i];
+      EXPECT_EQ(phase.taps[i], phase.paired_taps[i / 2 * 4 + i % 2]);
+      EXPECT_EQ(phase.taps[i], phase.paired_taps[i / 2 * 4 + i % 2 + 2]);
+    }
+    EXPECT_EQ(1 << 14, sum);
+  }
+}
+
+TEST(Mixer, ResamplerMatchesScalarTapLoop)
+{
+  std::mt19937 rng(0);
+  const Buffer buffer = MakeBuffer(rng);
+
+  // Read positions are always at the start of a sample pair. The last ones wrap around the end of
+  // the buffer, where the scalar loop is used either way.
+  for (u32 first = 0; first < Mixer::MAX_SAMPLES * 2; first += 2)
+  {
+    for (const Mixer::ResamplerPhase& phase : Mixer::GetResamplerFilter())
+    {
+      int left;
+      int right;
+      Mixer::ApplyResampler(buffer, first, phase, &left, &right);
+
+      int expected_left;
+      int expected_right;
+      ReferenceApplyResampler(buffer, first, phase, &expected_left, &expected_right);
+
+      ASSERT_EQ(expected_left, left) << "first " << first;
+      ASSERT_EQ(expected_right, right) << "first " << first;
+    }
+  }
+}
+
+TEST(Mixer, ResamplerKeepsConstantSignal)
+{
+  Buffer buffer;
+  for (size_t i = 0; i < buffer.size(); i += 2)
+  {
+    buffer[i] = Common::swap16(static_cast<u16>(-32768));
+    buffer[i + 1] = Common::swap16(static_cast<u16>(-1));
+  }
+
+  // Includes the positions where the filter wraps around the end of the buffer.
+  for (u32 first = Mixer::MAX_SAMPLES * 2 - Mixer::RESAMPLER_TAPS * 4;
+       first < Mixer::MAX_SAMPLES * 2; first += 2)
+  {
+    for (const Mixer::ResamplerPhase& phase : Mixer::GetResamplerFilter())
+    {
+      int left;
+      int right;
+      Mixer::ApplyResampler(buffer, first, phase, &left, &right);
+      ASSERT_EQ(-32768 * (1 << 14), left) << "first " << first;
+      ASSERT_EQ(-(1 << 14), right) << "first " << first;
+    }
+  }
+}
@@ -0,0 +1,130 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/SurroundDecoder.h"
+#include "Common/CommonTypes.h"
+
+using AudioCommon::SurroundFrameRing;
+
+namespace
+{
+constexpr size_t CHANNELS = SurroundFrameRing::CHANNELS;
+
+// Every sample encodes the number of its frame, so that dropped, repeated or reordered frames show
+// up in the values which are read back.
+void WriteFrames(SurroundFrameRing* ring, u32 first_frame, u32 num_frames)
+{
+  for (u32 i = 0; i < num_frames; ++i)
+  {
+    float* frame = ring->GetWriteFrame(i);
+    for (size_t channel = 0; channel < CHANNELS; ++channel)
+      frame[channel] = static_cast<float>((first_frame + i) * CHANNELS + channel);
+  }
+  ring->CommitFrames(num_frames);
+}
+
+void ExpectFrames(const std::vector<float>& out, u32 first_frame, size_t num_frames)
+{
+  for (size_t i = 0; i < num_frames * CHANNELS; ++i)
+    ASSERT_EQ(static_cast<float>(first_frame * CHANNELS + i), out[i]) << "sample " << i;
+}
+}  // namespace
+
+TEST(SurroundFrameRing, ReadsCommittedFramesOnly)
+{
+  auto ring = std::make_unique<SurroundFrameRing>();
+  std::vector<float> out(16 * CHANNELS);
+
+  WriteFrames(ring.get(), 0, 4);
+  // Written but not committed yet.
+  ring->GetWriteFrame(0)[0] = 1234.0f;
+
+  EXPECT_EQ(4u, ring->GetAvailableFrames());
+  EXPECT_EQ(4u, ring->ReadFrames(out.data(), 4));
+  ExpectFrames(out, 0, 4);
+  EXPECT_EQ(0u, ring->GetAvailableFrames());
+  EXPECT_EQ(SurroundFrameRing::CAPACITY_FRAMES, ring->GetFreeFrames());
+}
+
+TEST(SurroundFrameRing, PadsUnderrunWithSilence)
+{
+  auto ring = std::make_unique<SurroundFrameRing>();
+  std::vector<float> out(16 * CHANNELS, -1.0f);
+
+  WriteFrames(ring.get(), 0, 5);
+  EXPECT_EQ(5u, ring->ReadFrames(out.data(), 16));
+  ExpectFrames(out, 0, 5);
+  for (size_t i = 5 * CHANNELS; i < out.size(); ++i)
+    EXPECT_EQ(0.0f, out[i]) << "sample " << i;
+
+  // Nothing was consumed beyond what had been committed.
+  WriteFrames(ring.get(), 5, 3);
+  EXPECT_EQ(3u, ring->ReadFrames(out.data(), 3));
+  ExpectFrames(out, 5, 3);
+}
+
+TEST(SurroundFrameRing, WrapsAroundTheBuffer)
+{
+  auto ring = std::make_unique<SurroundFrameRing>();
+  constexpr u32 CHUNK_FRAMES = 1000;
+  std::vector<float> out(CHUNK_FRAMES * CHANNELS);
+
+  // Keep the ring nearly full so that reads and writes straddle the end of the buffer at
+  // different positions.
+  WriteFrames(ring.get(), 0, SurroundFrameRing::CAPACITY_FRAMES - CHUNK_FRAMES);
+  u32 next_read = 0;
+  u32 next_write = SurroundFrameRing::CAPACITY_FRAMES - CHUNK_FRAMES;
+  for (int i = 0; i < 50; ++i)
+  {
+    ASSERT_EQ(CHUNK_FRAMES, ring->GetFreeFrames());
+    WriteFrames(ring.get(), next_write, CHUNK_FRAMES);
+    next_write += CHUNK_FRAMES;
+    ASSERT_EQ(0u, ring->GetFreeFrames());
+
+    ASSERT_EQ(CHUNK_FRAMES, ring->ReadFrames(out.data(), CHUNK_FRAMES));
+    ExpectFrames(out, next_read, CHUNK_FRAMES);
+    next_read += CHUNK_FRAMES;
+  }
+}
+
+TEST(SurroundFrameRing, ProducerAndConsumerThreads)
+{
+  auto ring = std::make_unique<SurroundFrameRing>();
+  constexpr u32 TOTAL_FRAMES = 1 << 20;
+  constexpr u32 BLOCK_FRAMES = 256;
+
+  std::thread producer([&ring] {
+    for (u32 written = 0; written < TOTAL_FRAMES;)
+    {
+      if (ring->GetFreeFrames() < BLOCK_FRAMES)
+      {
+        std::this_thread::yield();
+        continue;
+      }
+      WriteFrames(ring.get(), written, BLOCK_FRAMES);
+      written += BLOCK_FRAMES;
+    }
+  });
+
+  // Read in sizes which don't line up with the blocks of the producer.
+  std::vector<float> out(333 * CHANNELS);
+  u32 read = 0;
+  while (read < TOTAL_FRAMES)
+  {
+    const size_t num_frames = ring->ReadFrames(out.data(), 333);
+    ExpectFrames(out, read, num_frames);
+    read += static_cast<u32>(num_frames);
+    if (num_frames == 0)
+      std::this_thread::yield();
+  }
+
+  producer.join();
+  EXPECT_EQ(0u, ring->GetAvailableFrames());
+}
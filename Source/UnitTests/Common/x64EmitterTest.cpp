@@ -1227,6 +1227,66 @@ AVX_RRMI_TEST(VSHUFPD, "dqword")
 AVX_RRMI_TEST(VBLENDPS, "dqword")
 AVX_RRMI_TEST(VBLENDPD, "dqword")
 
+TEST_F(x64EmitterTest, AVX2_256Bit)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VMULPS(256, r.reg, YMM1, MatR(R12));
+    emitter->VCVTDQ2PS(256, r.reg, R(YMM1));
+    emitter->VBROADCASTSS(256, r.reg, MatR(R12));
+    emitter->VPSHUFB(256, r.reg, YMM1, R(YMM2));
+    emitter->VPSRAD(256, r.reg, YMM1, 24);
+    emitter->VPSRLD(256, r.reg, YMM1, 16);
+    emitter->VBROADCASTI128(r.reg, MatR(R12));
+    emitter->VINSERTI128(r.reg, YMM1, R(XMM2), 1);
+    emitter->VEXTRACTI128(R(XMM1), r.reg, 1);
+    // The disassembler names 128-bit operands of the lane instructions after their 256-bit
+    // counterparts.
+    ExpectDisassembly("vmulps " + r.name + ", ymm1, qqword ptr ds:[r12] "
+                      "vcvtdq2ps " + r.name + ", ymm1 "
+                      "vbroadcastss " + r.name + ", dword ptr ds:[r12] "
+                      "vpshufb " + r.name + ", ymm1, ymm2 "
+                      "vpsrad " + r.name + ", ymm1, 0x18 "
+                      "vpsrld " + r.name + ", ymm1, 0x10 "
+                      "vbroadcasti128 " + r.name + ", qqword ptr ds:[r12] "
+                      "vinserti128 " + r.name + ", ymm1, ymm2, 0x01 "
+                      "vextracti128 ymm1, " + r.name + ", 0x01");
+  }
+}
+
+TEST_F(x64EmitterTest, AVX_Moves)
+{
+  for (const auto& r : xmmnames)
+  {
+    emitter->VMOVD_xmm(r.reg, MatR(R12));
+    emitter->VMOVQ_xmm(r.reg, MatR(R12));
+    emitter->VMOVQ_xmm(r.reg, R(RAX));
+    emitter->VMOVDQU(r.reg, MatR(R12));
+    emitter->VMOVSS(MatR(R12), r.reg);
+    emitter->VMOVLPS(MatR(R12), r.reg);
+    emitter->VMOVUPS(MatR(R12), r.reg);
+    emitter->VMOVHLPS(r.reg, XMM1, XMM2);
+    emitter->VCVTSI2SS(32, r.reg, XMM1, R(RAX));
+    emitter->VCVTSI2SS(64, r.reg, XMM1, R(RAX));
+    ExpectDisassembly("vmovd " + r.name + ", dword ptr ds:[r12] "
+                      "vmovq " + r.name + ", qword ptr ds:[r12] "
+                      "vmovq " + r.name + ", rax "
+                      "vmovdqu " + r.name + ", dqword ptr ds:[r12] "
+                      "vmovss dword ptr ds:[r12], " + r.name + " "
+                      "vmovlps qword ptr ds:[r12], " + r.name + " "
+                      "vmovups dqword ptr ds:[r12], " + r.name + " "
+                      "vmovhlps " + r.name + ", xmm1, xmm2 "
+                      "vcvtsi2ss " + r.name + ", xmm1, eax "
+                      "vcvtsi2ss " + r.name + ", xmm1, rax");
+  }
+}
+
+TEST_F(x64EmitterTest, VZEROUPPER)
+{
+  emitter->VZEROUPPER();
+  ExpectDisassembly("vzeroupper");
+}
+
 // for VEX instructions that take the form op reg, reg, r/m, reg OR reg, reg, reg, r/m
 #define VEX_RRMR_RRRM_TEST(Name, sizename)                                                         \
   TEST_F(x64EmitterTest, Name)                                                                     \
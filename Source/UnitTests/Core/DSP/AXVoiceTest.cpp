@@ -0,0 +1,192 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+
+#define AX_WII
+#include "Core/HW/DSPHLE/UCodes/AXVoice.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceWorkers.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+constexpr u16 TEST_VOLUMES[] = {0x0000, 0x0001, 0x7fff, 0x8000, 0x8001, 0xc000, 0xffff};
+constexpr u16 TEST_DELTAS[] = {0x0000, 0x0001, 0x0123, 0x7fff, 0x8000, 0xfff0, 0xffff};
+
+// The scalar MixAdd the vectorized one is compared against.
+void ReferenceMixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
+{
+  u16& volume = pvol[0];
+  u16 volume_delta = pvol[1];
+  if (!ramp)
+    volume_delta = 0;
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);
+
+    out[i] += (s16)sample;
+    volume += volume_delta;
+
+    *dpop = (s16)sample;
+  }
+}
+
+std::array<s16, MAX_SAMPLES_PER_FRAME> MakeSamples(std::mt19937& rng)
+{
+  std::array<s16, MAX_SAMPLES_PER_FRAME> samples;
+  std::uniform_int_distribution<int> distribution(-32768, 32767);
+  for (s16& sample : samples)
+    sample = static_cast<s16>(distribution(rng));
+  // Make sure that the extreme values are covered.
+  samples[0] = -32768;
+  samples[1] = 32767;
+  samples[9] = -32768;
+  return samples;
+}
+}  // namespace
+
+TEST(AXVoice, MixAddMatchesScalar)
+{
+  std::mt19937 rng(1234);
+  for (u32 count : {0, 1, 3, 8, 13, 32, 95, 96})
+  {
+    for (u16 volume : TEST_VOLUMES)
+    {
+      for (u16 delta : TEST_DELTAS)
+      {
+        for (bool ramp : {false, true})
+        {
+          const auto input = MakeSamples(rng);
+          std::array<int, MAX_SAMPLES_PER_FRAME> expected_out, actual_out;
+          expected_out.fill(100);
+          actual_out.fill(100);
+          u16 expected_vol[2] = {volume, delta};
+          u16 actual_vol[2] = {volume, delta};
+          s16 expected_dpop = 7;
+          s16 actual_dpop = 7;
+
+          ReferenceMixAdd(expected_out.data(), input.data(), count, expected_vol, &expected_dpop,
+                          ramp);
+          MixAdd(actual_out.data(), input.data(), count, actual_vol, &actual_dpop, ramp);
+
+          EXPECT_EQ(expected_out, actual_out);
+          EXPECT_EQ(expected_vol[0], actual_vol[0]);
+          EXPECT_EQ(expected_vol[1], actual_vol[1]);
+          EXPECT_EQ(expected_dpop, actual_dpop);
+        }
+      }
+    }
+  }
+}
+
+TEST(AXVoice, ApplyVolumeMatchesScalar)
+{
+  std::mt19937 rng(5678);
+  for (u32 count : {0, 5, 16, 17, 96})
+  {
+    for (u16 volume : TEST_VOLUMES)
+    {
+      for (u16 delta : TEST_DELTAS)
+      {
+        auto expected = MakeSamples(rng);
+        auto actual = expected;
+
+        u16 expected_volume = volume;
+        for (u32 i = 0; i < count; ++i)
+        {
+          expected[i] = std::clamp(((s32)expected[i] * expected_volume) >> 15, -32767, 32767);
+          expected_volume += delta;
+        }
+
+        // In place, like the volume envelope of a voice.
+        u16 actual_volume = volume;
+        ApplyVolume(actual.data(), actual.data(), count, actual_volume, delta);
+
+        EXPECT_EQ(expected, actual);
+        EXPECT_EQ(expected_volume, actual_volume);
+      }
+    }
+  }
+}
+
+// The block reader must not read ahead of the resampler, as accelerator reads have side effects.
+TEST(AXVoice, ResampleInputCount)
+{
+  for (int srctype : {SRCTYPE_NEAREST, SRCTYPE_LINEAR, SRCTYPE_POLYPHASE})
+  {
+    for (u32 ratio : {0x00000000u, 0x00001234u, 0x00010000u, 0x00018000u, 0x0004ffffu,
+                      0xffff0000u, 0xffffffffu})
+    {
+      for (u32 curr_pos : {0x0000u, 0x8000u, 0xffffu})
+      {
+        std::array<s16, MAX_SAMPLES_PER_FRAME> output;
+        s16 last_samples[4] = {};
+        u32 read_count = 0;
+        ResampleAudio(
+            [&read_count](u32) {
+              ++read_count;
+              return s16{0};
+            },
+            output.data(), MAX_SAMPLES_PER_FRAME, last_samples, curr_pos, ratio, srctype, nullptr);
+
+        EXPECT_EQ(read_count,
+                  GetResampleInputCount(MAX_SAMPLES_PER_FRAME, curr_pos, ratio, srctype));
+      }
+    }
+  }
+}
+
+// Mixing voices on several threads must give the same output as mixing them serially.
+TEST(AXVoice, WorkersMatchSerialMixing)
+{
+  constexpr u32 NUM_VOICES = 37;
+  static constexpr u32 SIZES[] = {96, 96, 18};
+
+  const auto mix_voice = [](u32 voice, int* const* buffers) {
+    for (u32 i = 0; i < std::size(SIZES); ++i)
+    {
+      for (u32 j = 0; j < SIZES[i]; ++j)
+        buffers[i][j] += static_cast<int>((voice * 7919 + i * 104729 + j * 31) % 65536) - 32768;
+    }
+  };
+
+  std::vector<std::vector<int>> expected;
+  for (u32 size : SIZES)
+    expected.emplace_back(size, 5);
+  for (u32 voice = 0; voice < NUM_VOICES; ++voice)
+  {
+    int* const buffers[] = {expected[0].data(), expected[1].data(), expected[2].data()};
+    mix_voice(voice, buffers);
+  }
+
+  for (u32 num_workers : {1, 2, 3, 8})
+  {
+    AXVoiceWorkers workers(num_workers);
+    // Run several times, as the workers are reused across frames.
+    for (int frame = 0; frame < 3; ++frame)
+    {
+      std::vector<std::vector<int>> actual;
+      std::vector<AXVoiceWorkers::MixBuffer> mix_buffers;
+      for (u32 size : SIZES)
+        actual.emplace_back(size, 5);
+      for (std::vector<int>& buffer : actual)
+        mix_buffers.push_back({buffer.data(), static_cast<u32>(buffer.size())});
+
+      workers.ProcessVoices(NUM_VOICES, mix_buffers, mix_voice);
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
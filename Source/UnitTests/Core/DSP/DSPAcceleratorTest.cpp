@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <array>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -34,6 +35,77 @@ protected:
   bool m_accov_raised = false;
 };
 
+// Accelerator reading from a buffer, which loops like the AX ucodes do.
+class BufferAccelerator : public DSP::Accelerator
+{
+public:
+  explicit BufferAccelerator(bool looping) : m_looping(looping)
+  {
+    for (size_t i = 0; i < m_memory.size(); ++i)
+      m_memory[i] = static_cast<u8>(i * 113 + (i >> 3) * 29);
+  }
+
+protected:
+  void OnEndException() override
+  {
+    if (m_looping)
+      SetYn2(GetYn2());
+  }
+  u8 ReadMemory(u32 address) override { return m_memory[address % m_memory.size()]; }
+  void WriteMemory(u32 address, u8 value) override {}
+
+  std::array<u8, 0x100> m_memory;
+  bool m_looping;
+};
+
+// ReadSamples must give the same samples and leave the accelerator in the same state as
+// repeated calls to Read.
+TEST(DSPAccelerator, ReadSamplesMatchesRead)
+{
+  std::array<s16, 16> coefs;
+  for (size_t i = 0; i < coefs.size(); ++i)
+    coefs[i] = static_cast<s16>(i * 0x1357 - 0x4000);
+
+  for (u16 format : {0x00, 0x0A, 0x19})
+  {
+    for (bool looping : {false, true})
+    {
+      for (u32 start = 0x20; start < 0x24; ++start)
+      {
+        for (u32 end = 0x5e; end < 0x63; ++end)
+        {
+          BufferAccelerator expected(looping), actual(looping);
+          for (DSP::Accelerator* accelerator : {static_cast<DSP::Accelerator*>(&expected),
+                                                static_cast<DSP::Accelerator*>(&actual)})
+          {
+            accelerator->SetSampleFormat(format);
+            accelerator->SetStartAddress(start);
+            accelerator->SetEndAddress(end);
+            accelerator->SetCurrentAddress(start);
+            accelerator->SetPredScale(0x2a);
+            accelerator->SetYn1(0x1234);
+            accelerator->SetYn2(-0x789);
+          }
+
+          for (u32 count : {1, 7, 14, 15, 96, 200})
+          {
+            std::vector<s16> expected_samples(count), actual_samples(count);
+            for (s16& sample : expected_samples)
+              sample = static_cast<s16>(expected.Read(coefs.data()));
+            actual.ReadSamples(coefs.data(), actual_samples.data(), count);
+
+            EXPECT_EQ(expected_samples, actual_samples);
+            EXPECT_EQ(expected.GetCurrentAddress(), actual.GetCurrentAddress());
+            EXPECT_EQ(expected.GetPredScale(), actual.GetPredScale());
+            EXPECT_EQ(expected.GetYn1(), actual.GetYn1());
+            EXPECT_EQ(expected.GetYn2(), actual.GetYn2());
+          }
+        }
+      }
+    }
+  }
+}
+
 TEST(DSPAccelerator, Initialization)
 {
   TestAccelerator accelerator;
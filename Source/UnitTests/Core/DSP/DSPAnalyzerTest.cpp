@@ -0,0 +1,100 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCodeUtil.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPTables.h"
+
+namespace
+{
+// Assembles code to the start of IRAM and returns whether the analyzer marks the first
+// instruction as an idle skip.
+bool IsIdleSkipAtStart(const std::string& code)
+{
+  std::vector<u16> binary;
+  if (!DSP::Assemble(code, binary))
+  {
+    ADD_FAILURE() << "Assembly failed";
+    return false;
+  }
+
+  // Rest of IRAM and IROM are NOPs.
+  std::array<u16, DSP::DSP_IRAM_SIZE> iram{};
+  std::array<u16, DSP::DSP_IROM_SIZE> irom{};
+  std::copy(binary.begin(), binary.end(), iram.begin());
+
+  DSP::InitInstructionTable();
+
+  DSP::DSPCore core;
+  DSP::SDSP& dsp = core.DSPState();
+  dsp.iram = iram.data();
+  dsp.irom = irom.data();
+
+  DSP::Analyzer analyzer;
+  analyzer.Analyze(dsp);
+
+  dsp.iram = nullptr;
+  dsp.irom = nullptr;
+  return analyzer.IsIdleSkip(0);
+}
+}  // namespace
+
+// These loops don't match any of the idle skip signatures.
+TEST(DSPAnalyzer, FindsDMBHPollingLoop)
+{
+  EXPECT_TRUE(IsIdleSkipAtStart("poll:\n"
+                                "  lr $AC0.M, @DMBH\n"
+                                "  andcf $AC0.M, #0x8000\n"
+                                "  jlz poll\n"));
+}
+
+TEST(DSPAnalyzer, FindsCMBHPollingLoop)
+{
+  EXPECT_TRUE(IsIdleSkipAtStart("poll:\n"
+                                "  lrs $AC1.M, @CMBH\n"
+                                "  andf $AC1.M, #0x8000\n"
+                                "  jlnz poll\n"));
+}
+
+TEST(DSPAnalyzer, IgnoresTestOfOtherRegister)
+{
+  EXPECT_FALSE(IsIdleSkipAtStart("poll:\n"
+                                 "  lrs $AC1.M, @DMBH\n"
+                                 "  andcf $AC0.M, #0x8000\n"
+                                 "  jlz poll\n"));
+}
+
+TEST(DSPAnalyzer, IgnoresUnconditionalJump)
+{
+  EXPECT_FALSE(IsIdleSkipAtStart("poll:\n"
+                                 "  lrs $AC0.M, @DMBH\n"
+                                 "  andcf $AC0.M, #0x8000\n"
+                                 "  jmp poll\n"));
+}
+
+TEST(DSPAnalyzer, IgnoresNonMailboxAddress)
+{
+  EXPECT_FALSE(IsIdleSkipAtStart("poll:\n"
+                                 "  lrs $AC0.M, @CMBL\n"
+                                 "  andcf $AC0.M, #0x8000\n"
+                                 "  jlz poll\n"));
+}
+
+TEST(DSPAnalyzer, IgnoresJumpElsewhere)
+{
+  EXPECT_FALSE(IsIdleSkipAtStart("  lrs $AC1.M, @CMBH\n"
+                                 "  andf $AC1.M, #0x8000\n"
+                                 "  jlnz done\n"
+                                 "done:\n"
+                                 "  nop\n"));
+}
@@ -0,0 +1,201 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/Zelda.h"
+
+using namespace DSP::HLE;
+
+// The reference implementations below are the sample-by-sample versions of the buffer operations
+// the Zelda audio renderer used before they were vectorized.
+namespace
+{
+constexpr size_t TEST_COUNTS[] = {0, 1, 7, 8, 0x28, 0x4f, 0x50};
+constexpr u16 TEST_VOLUMES[] = {0x0000, 0x0001, 0x6784, 0x7fff, 0x8000, 0xb820, 0xffff};
+
+std::vector<s16> MakeSamples(std::mt19937& rng, size_t count)
+{
+  std::vector<s16> samples(count);
+  std::uniform_int_distribution<int> distribution(-32768, 32767);
+  for (s16& sample : samples)
+    sample = static_cast<s16>(distribution(rng));
+  // Make sure that the extreme values are covered.
+  for (size_t i = 0; i < std::min<size_t>(count, 4); ++i)
+    samples[i] = i % 2 ? 32767 : -32768;
+  return samples;
+}
+
+void ReferenceApplyVolumeInPlace(s16* buf, size_t count, u16 vol, u32 int_bits)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    s32 tmp = (u32)buf[i] * (u32)vol;
+    tmp >>= 16 - int_bits;
+
+    buf[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
+  }
+}
+
+s32 ReferenceAddBuffersWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step)
+{
+  u32 volume = static_cast<u32>(vol);
+  for (size_t i = 0; i < count; ++i)
+  {
+    dst[i] += ((static_cast<s32>(volume) >> 16) * src[i]) >> 16;
+    volume += step;
+  }
+  return static_cast<s32>(volume);
+}
+
+void ReferenceAddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  while (count--)
+  {
+    s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
+    *dst++ += std::clamp(vol_src, -0x8000, 0x7FFF);
+  }
+}
+
+void ReferenceApplyFilterInPlace(s16* buf, size_t count, const s16* coeffs)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    // Accumulated in u32, as the sum of the extreme inputs wraps around.
+    u32 sample = 0;
+    for (size_t j = 0; j < 8; ++j)
+      sample += static_cast<u32>(buf[i + j] * coeffs[j]);
+    buf[i] = std::clamp(static_cast<s32>(sample) >> 15, -0x8000, 0x7FFF);
+  }
+}
+
+u32 ReferenceResample(const s16* src, s16* dst, size_t count, u32 pos, u32 ratio,
+                      const s16* coeffs)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    const s16* sample_coeffs = &coeffs[((pos & 0xFFF) >> 6) * 4];
+    const s16* input = &src[pos >> 12];
+
+    s64 dst_sample_unclamped = 0;
+    for (size_t j = 0; j < 4; ++j)
+      dst_sample_unclamped += (s64)2 * sample_coeffs[j] * input[j];
+    dst_sample_unclamped >>= 16;
+
+    dst[i] = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
+    pos += ratio;
+  }
+  return pos;
+}
+}  // namespace
+
+TEST(ZeldaMixing, ApplyVolumeInPlace)
+{
+  std::mt19937 rng(1);
+  for (size_t count : TEST_COUNTS)
+  {
+    for (u16 volume : TEST_VOLUMES)
+    {
+      for (u32 int_bits : {1, 4})
+      {
+        std::vector<s16> expected = MakeSamples(rng, count);
+        std::vector<s16> actual = expected;
+        ReferenceApplyVolumeInPlace(expected.data(), count, volume, int_bits);
+        ZeldaMixing::ApplyVolumeInPlace(actual.data(), count, volume, int_bits);
+        EXPECT_EQ(expected, actual);
+      }
+    }
+  }
+}
+
+TEST(ZeldaMixing, AddBuffersWithVolumeRamp)
+{
+  std::mt19937 rng(2);
+  constexpr s32 TEST_RAMP_VOLUMES[] = {0, 0x7fff0000, -0x7fffffff - 1, 0x12345678, -0x1000000};
+  constexpr s32 TEST_STEPS[] = {0, 1, -1, 0x10000, -0x333333, 0x7fffffff};
+  for (size_t count : TEST_COUNTS)
+  {
+    for (s32 volume : TEST_RAMP_VOLUMES)
+    {
+      for (s32 step : TEST_STEPS)
+      {
+        const std::vector<s16> src = MakeSamples(rng, count);
+        std::vector<s16> expected = MakeSamples(rng, count);
+        std::vector<s16> actual = expected;
+        const s32 expected_volume =
+            ReferenceAddBuffersWithVolumeRamp(expected.data(), src.data(), count, volume, step);
+        const s32 actual_volume =
+            ZeldaMixing::AddBuffersWithVolumeRamp(actual.data(), src.data(), count, volume, step);
+        EXPECT_EQ(expected, actual);
+        EXPECT_EQ(expected_volume, actual_volume);
+      }
+    }
+  }
+}
+
+TEST(ZeldaMixing, AddBuffersWithVolume)
+{
+  std::mt19937 rng(3);
+  for (size_t count : TEST_COUNTS)
+  {
+    for (u16 volume : TEST_VOLUMES)
+    {
+      const std::vector<s16> src = MakeSamples(rng, count);
+      std::vector<s16> expected = MakeSamples(rng, count);
+      std::vector<s16> actual = expected;
+      ReferenceAddBuffersWithVolume(expected.data(), src.data(), count, volume);
+      ZeldaMixing::AddBuffersWithVolume(actual.data(), src.data(), count, volume);
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(ZeldaMixing, ApplyFilterInPlace)
+{
+  std::mt19937 rng(4);
+  for (size_t count : TEST_COUNTS)
+  {
+    for (int i = 0; i < 8; ++i)
+    {
+      const std::vector<s16> coeffs = MakeSamples(rng, 8);
+      std::vector<s16> expected = MakeSamples(rng, count + 7);
+      std::vector<s16> actual = expected;
+      ReferenceApplyFilterInPlace(expected.data(), count, coeffs.data());
+      ZeldaMixing::ApplyFilterInPlace(actual.data(), count, coeffs.data());
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(ZeldaMixing, Resample)
+{
+  std::mt19937 rng(5);
+  // Only ratios below 4:1 are resampled with the filter.
+  for (u32 ratio : {0x0000u, 0x0001u, 0x0800u, 0x1000u, 0x1234u, 0x3fffu})
+  {
+    for (u32 pos : {0x000u, 0x040u, 0xfffu})
+    {
+      std::vector<s16> coeffs = MakeSamples(rng, 0x100);
+      // Saturate the sums of both halves of the filter.
+      std::fill(coeffs.begin(), coeffs.begin() + 4, -0x8000);
+      std::vector<s16> src = MakeSamples(rng, 0x500 + 4);
+      std::fill(src.begin(), src.begin() + 8, -0x8000);
+
+      std::array<s16, 0x50> expected;
+      std::array<s16, 0x50> actual;
+      const u32 expected_pos = ReferenceResample(src.data(), expected.data(), expected.size(), pos,
+                                                 ratio, coeffs.data());
+      const u32 actual_pos = ZeldaMixing::Resample(src.data(), actual.data(), actual.size(), pos,
+                                                   ratio, coeffs.data());
+      EXPECT_EQ(expected, actual);
+      EXPECT_EQ(expected_pos, actual_pos);
+    }
+  }
+}
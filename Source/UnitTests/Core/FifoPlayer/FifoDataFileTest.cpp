@@ -0,0 +1,139 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+
+namespace
+{
+FifoFrameInfo MakeFrame(u32 index, u32 num_updates)
+{
+  FifoFrameInfo frame;
+  frame.fifoStart = 0x00200000;
+  frame.fifoEnd = 0x00300000;
+  frame.fifoData.assign(0x1000, static_cast<u8>(index));
+  for (u32 i = 0; i < num_updates; ++i)
+  {
+    MemoryUpdate update;
+    update.fifoPosition = i * 0x10;
+    update.address = 0x00400000 + i * 0x10000;
+    update.type = MemoryUpdate::TEXTURE_MAP;
+    // The contents only depend on i, so every frame uploads the same data.
+    update.data.resize(0x10000);
+    for (size_t j = 0; j < update.data.size(); ++j)
+      update.data[j] = static_cast<u8>(j * 31 + (j >> 7) * 17 + i);
+    frame.memoryUpdates.push_back(std::move(update));
+  }
+  return frame;
+}
+
+// Large enough to not fit in the read buffer of the file, even when compressed.
+FifoFrameInfo MakeIncompressibleFrame(u32 index)
+{
+  FifoFrameInfo frame = MakeFrame(index, 1);
+  frame.fifoData.resize(0x10000);
+  u32 state = index + 1;
+  for (u8& value : frame.fifoData)
+  {
+    state = state * 1103515245 + 12345;
+    value = static_cast<u8>(state >> 24);
+  }
+  return frame;
+}
+
+void ExpectSameFrame(const FifoFrameInfo& expected, const FifoFrameInfo& actual)
+{
+  EXPECT_EQ(expected.fifoStart, actual.fifoStart);
+  EXPECT_EQ(expected.fifoEnd, actual.fifoEnd);
+  EXPECT_EQ(expected.fifoData, actual.fifoData);
+  ASSERT_EQ(expected.memoryUpdates.size(), actual.memoryUpdates.size());
+  for (size_t i = 0; i < expected.memoryUpdates.size(); ++i)
+  {
+    EXPECT_EQ(expected.memoryUpdates[i].fifoPosition, actual.memoryUpdates[i].fifoPosition);
+    EXPECT_EQ(expected.memoryUpdates[i].address, actual.memoryUpdates[i].address);
+    EXPECT_EQ(expected.memoryUpdates[i].type, actual.memoryUpdates[i].type);
+    EXPECT_EQ(expected.memoryUpdates[i].data, actual.memoryUpdates[i].data);
+  }
+}
+}  // namespace
+
+TEST(FifoDataFile, StreamedFramesRoundTrip)
+{
+  const std::string dir = File::CreateTempDir();
+  ASSERT_FALSE(dir.empty());
+  const std::string scratch_path = dir + "/scratch.dff";
+  const std::string path = dir + "/saved.dff";
+
+  constexpr u32 FRAME_COUNT = 20;
+  constexpr u32 UPDATES_PER_FRAME = 8;
+  {
+    auto file = std::make_unique<FifoDataFile>();
+    ASSERT_TRUE(file->StreamToFile(scratch_path, true));
+    file->SetIsWii(true);
+    file->GetBPMem()[0x40] = 0x12345678;
+    for (u32 i = 0; i < FRAME_COUNT; ++i)
+      file->AddFrame(MakeFrame(i, UPDATES_PER_FRAME));
+
+    // Frames can be read back while they are being streamed to disk.
+    ExpectSameFrame(MakeFrame(3, UPDATES_PER_FRAME), *file->GetFrame(3));
+    ASSERT_TRUE(file->Save(path));
+  }
+  EXPECT_FALSE(File::Exists(scratch_path));
+
+  // The memory updates of all frames share the data written for the first one. Besides them, the
+  // file mostly holds the uncompressed texture memory.
+  EXPECT_LT(File::GetSize(path), FifoDataFile::TEX_MEM_SIZE + u64{UPDATES_PER_FRAME} * 0x10000);
+
+  const std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(path, false);
+  ASSERT_NE(nullptr, file);
+  EXPECT_TRUE(file->GetIsWii());
+  EXPECT_EQ(0x12345678u, file->GetBPMem()[0x40]);
+  ASSERT_EQ(FRAME_COUNT, file->GetFrameCount());
+  for (u32 i = 0; i < FRAME_COUNT; ++i)
+    ExpectSameFrame(MakeFrame(i, UPDATES_PER_FRAME), *file->GetFrame(i));
+
+  File::DeleteDirRecursively(dir);
+}
+
+TEST(FifoDataFile, SaveLoadedFileOverItself)
+{
+  const std::string dir = File::CreateTempDir();
+  ASSERT_FALSE(dir.empty());
+  const std::string path = dir + "/saved.dff";
+
+  constexpr u32 FRAME_COUNT = 10;
+  {
+    auto file = std::make_unique<FifoDataFile>();
+    ASSERT_TRUE(file->StreamToFile(path, false));
+    for (u32 i = 0; i < FRAME_COUNT; ++i)
+      file->AddFrame(MakeIncompressibleFrame(i));
+    ASSERT_TRUE(file->Save(path));
+  }
+
+  // The frames of the loaded file are read from the file which is being replaced.
+  const std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(path, false);
+  ASSERT_NE(nullptr, file);
+  ExpectSameFrame(MakeIncompressibleFrame(0), *file->GetFrame(0));
+  ASSERT_TRUE(file->Save(path));
+  EXPECT_FALSE(File::Exists(File::GetTempFilenameForAtomicWrite(path)));
+
+  // Both the file on disk and the loaded file still have every frame.
+  for (u32 i = 0; i < FRAME_COUNT; ++i)
+    ExpectSameFrame(MakeIncompressibleFrame(i), *file->GetFrame(i));
+
+  const std::unique_ptr<FifoDataFile> reloaded = FifoDataFile::Load(path, false);
+  ASSERT_NE(nullptr, reloaded);
+  ASSERT_EQ(FRAME_COUNT, reloaded->GetFrameCount());
+  for (u32 i = 0; i < FRAME_COUNT; ++i)
+    ExpectSameFrame(MakeIncompressibleFrame(i), *reloaded->GetFrame(i));
+
+  File::DeleteDirRecursively(dir);
+}
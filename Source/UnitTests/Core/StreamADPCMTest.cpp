@@ -0,0 +1,91 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/StreamADPCM.h"
+
+namespace
+{
+// The per-sample decoder the block decoder is compared against.
+s16 ReferenceDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
+{
+  s32 hist = 0;
+  switch (q >> 4)
+  {
+  case 0:
+    hist = 0;
+    break;
+  case 1:
+    hist = (hist1 * 0x3c);
+    break;
+  case 2:
+    hist = (hist1 * 0x73) - (hist2 * 0x34);
+    break;
+  case 3:
+    hist = (hist1 * 0x62) - (hist2 * 0x37);
+    break;
+  }
+  hist = std::clamp((hist + 0x20) >> 6, -0x200000, 0x1fffff);
+
+  s32 cur = (((s16)(bits << 12) >> (q & 0xf)) << 6) + hist;
+
+  hist2 = hist1;
+  hist1 = cur;
+
+  cur >>= 6;
+  cur = std::clamp(cur, -0x8000, 0x7fff);
+
+  return (s16)cur;
+}
+}  // namespace
+
+TEST(StreamADPCM, DecodeBlocksMatchesReference)
+{
+  constexpr size_t BLOCK_COUNT = 64;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> distribution(0, 255);
+
+  std::vector<u8> adpcm(BLOCK_COUNT * StreamADPCM::ONE_BLOCK_SIZE);
+  for (u8& byte : adpcm)
+    byte = static_cast<u8>(distribution(rng));
+  // Cover every filter, including the undefined ones, with small and large shifts.
+  for (size_t i = 0; i < BLOCK_COUNT; ++i)
+  {
+    adpcm[i * StreamADPCM::ONE_BLOCK_SIZE] = static_cast<u8>((i % 16) << 4 | (i % 3 ? 0 : 12));
+    adpcm[i * StreamADPCM::ONE_BLOCK_SIZE + 1] = static_cast<u8>(((i + 5) % 16) << 4 | (i % 13));
+  }
+
+  std::vector<s16> expected(BLOCK_COUNT * StreamADPCM::SAMPLES_PER_BLOCK * 2);
+  s32 histl1 = 0, histl2 = 0, histr1 = 0, histr2 = 0;
+  for (size_t block = 0; block < BLOCK_COUNT; ++block)
+  {
+    const u8* adpcm_block = &adpcm[block * StreamADPCM::ONE_BLOCK_SIZE];
+    const u8* adpcm_data =
+        adpcm_block + (StreamADPCM::ONE_BLOCK_SIZE - StreamADPCM::SAMPLES_PER_BLOCK);
+    s16* pcm = &expected[block * StreamADPCM::SAMPLES_PER_BLOCK * 2];
+    for (int i = 0; i < StreamADPCM::SAMPLES_PER_BLOCK; i++)
+    {
+      const u8 data = adpcm_data[i];
+      pcm[i * 2] = ReferenceDecodeSample(data & 0xf, adpcm_block[0], histl1, histl2);
+      pcm[i * 2 + 1] = ReferenceDecodeSample(data >> 4, adpcm_block[1], histr1, histr2);
+    }
+  }
+
+  StreamADPCM::ADPCMDecoder decoder;
+  std::vector<s16> actual(expected.size());
+  // Decode in uneven batches, as the filter state has to carry over between calls.
+  decoder.DecodeBlocks(actual.data(), adpcm.data(), 5);
+  decoder.DecodeBlock(&actual[5 * StreamADPCM::SAMPLES_PER_BLOCK * 2],
+                      &adpcm[5 * StreamADPCM::ONE_BLOCK_SIZE]);
+  decoder.DecodeBlocks(&actual[6 * StreamADPCM::SAMPLES_PER_BLOCK * 2],
+                       &adpcm[6 * StreamADPCM::ONE_BLOCK_SIZE], BLOCK_COUNT - 6);
+
+  EXPECT_EQ(expected, actual);
+}
@@ -0,0 +1,114 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/EfbInterface.h"
+#include "VideoBackends/Software/Rasterizer.h"
+#include "VideoBackends/Software/TextureEncoder.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/TextureCacheBase.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/VideoConfig.h"
+
+// Compares the SIMD and multi-threaded EFB copy encoders against the scalar ones.
+class TextureEncoderTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Fills both the color and the depth buffer.
+    std::mt19937 rng(1234);
+    u8* efb = EfbInterface::GetPixelPointer(0, 0, false);
+    for (u32 i = 0; i < EFB_WIDTH * EFB_HEIGHT * 6; i++)
+      efb[i] = static_cast<u8>(rng());
+
+    // Makes sure that large copies are split across threads.
+    g_ActiveConfig.iSWRasterizerThreads = 4;
+    Rasterizer::Init();
+  }
+
+  void TearDown() override { Rasterizer::Shutdown(); }
+
+  void CompareEncoders(PEControl::PixelFormat efb_format, EFBCopyFormat copy_format, bool yuv,
+                       bool half_scale, const MathUtil::Rectangle<int>& rect)
+  {
+    const bool depth = efb_format == PEControl::Z24;
+    const EFBCopyParams params(efb_format, copy_format, depth, yuv, false);
+
+    const int width = rect.GetWidth();
+    const int height = rect.GetHeight();
+    bpmem.copyTexSrcWH.x = width - 1;
+    bpmem.copyTexSrcWH.y = height - 1;
+    bpmem.triggerEFBCopy.half_scale = half_scale;
+
+    // Large enough for blocks of up to 4 texels wide and 64 bytes, plus the extra block the
+    // encoders write at the end of each row.
+    const u32 blocks_per_row = ((width >> half_scale) >> 2) + 1;
+    const u32 rows_of_blocks = ((height >> half_scale) >> 2) + 1;
+    bpmem.copyMipMapStrideChannels = blocks_per_row * 2;
+    const size_t size = blocks_per_row * 64 * rows_of_blocks;
+
+    std::vector<u8> expected(size, 0xcd);
+    std::vector<u8> actual(size, 0xcd);
+    TextureEncoder::EncodeEfbCopy(expected.data(), params, rect, half_scale, true);
+    TextureEncoder::EncodeEfbCopy(actual.data(), params, rect, half_scale);
+
+    EXPECT_EQ(expected, actual) << fmt::format(
+        "efb format {}, copy format {}, yuv {}, half scale {}, {}x{} at {},{}",
+        static_cast<int>(efb_format), static_cast<int>(copy_format), yuv, half_scale, width, height,
+        rect.left, rect.top);
+  }
+};
+
+TEST_F(TextureEncoderTest, ColorFormats)
+{
+  const EFBCopyFormat copy_formats[] = {
+      EFBCopyFormat::R4,     EFBCopyFormat::R8_0x1, EFBCopyFormat::RA4,   EFBCopyFormat::RA8,
+      EFBCopyFormat::RGB565, EFBCopyFormat::RGB5A3, EFBCopyFormat::RGBA8, EFBCopyFormat::A8,
+      EFBCopyFormat::R8,     EFBCopyFormat::G8,     EFBCopyFormat::B8,    EFBCopyFormat::RG8,
+      EFBCopyFormat::GB8};
+  const MathUtil::Rectangle<int> rects[] = {
+      {0, 0, 640, 528}, {2, 4, 16, 12}, {10, 20, 333, 250}, {100, 6, 612, 133}};
+
+  for (const auto efb_format : {PEControl::RGBA6_Z24, PEControl::RGB8_Z24, PEControl::RGB565_Z16})
+  {
+    for (const EFBCopyFormat copy_format : copy_formats)
+    {
+      for (const bool yuv : {false, true})
+      {
+        for (const bool half_scale : {false, true})
+        {
+          for (const auto& rect : rects)
+            CompareEncoders(efb_format, copy_format, yuv, half_scale, rect);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TextureEncoderTest, DepthFormats)
+{
+  const EFBCopyFormat copy_formats[] = {EFBCopyFormat::R4,    EFBCopyFormat::R8_0x1,
+                                        EFBCopyFormat::RGBA8, EFBCopyFormat::R8,
+                                        EFBCopyFormat::G8,    EFBCopyFormat::B8,
+                                        EFBCopyFormat::RG8,   EFBCopyFormat::GB8};
+  const MathUtil::Rectangle<int> rects[] = {{0, 0, 640, 528}, {2, 4, 16, 12}, {10, 20, 333, 250}};
+
+  for (const EFBCopyFormat copy_format : copy_formats)
+  {
+    for (const bool half_scale : {false, true})
+    {
+      for (const auto& rect : rects)
+        CompareEncoders(PEControl::Z24, copy_format, false, half_scale, rect);
+    }
+  }
+}
@@ -0,0 +1,128 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/AdaptiveSyncDistance.h"
+
+using Fifo::AdaptiveSyncDistance;
+
+namespace
+{
+constexpr int WINDOW = 1000;
+constexpr int LOWER = 4000;
+constexpr int UPPER = 200000;
+constexpr int STEP = 1000;
+
+void RunWindow(AdaptiveSyncDistance& sync, int stalls, u64 stall_us)
+{
+  for (int i = 0; i < stalls; ++i)
+    sync.AddStall(stall_us);
+  sync.Update(WINDOW, WINDOW, LOWER, UPPER, STEP);
+}
+}  // namespace
+
+TEST(AdaptiveSyncDistance, ReevaluatesOncePerWindow)
+{
+  AdaptiveSyncDistance sync(80000);
+  for (int i = 0; i < 3; ++i)
+    sync.AddStall(1);
+  sync.Update(WINDOW / 2, WINDOW, LOWER, UPPER, STEP);
+  EXPECT_EQ(80000, sync.GetDistance());
+  sync.Update(WINDOW / 2, WINDOW, LOWER, UPPER, STEP);
+  EXPECT_EQ(80000 + 80000 / 4 + STEP, sync.GetDistance());
+}
+
+TEST(AdaptiveSyncDistance, ShrinksAfterCalmWindows)
+{
+  AdaptiveSyncDistance sync(80000);
+  for (int i = 1; i < AdaptiveSyncDistance::CALM_WINDOWS_TO_SHRINK; ++i)
+  {
+    RunWindow(sync, 0, 0);
+    EXPECT_EQ(80000, sync.GetDistance());
+  }
+  RunWindow(sync, 0, 0);
+  EXPECT_EQ(75000, sync.GetDistance());
+
+  // A window with a stall starts the count over, even if it doesn't change the distance.
+  for (int i = 1; i < AdaptiveSyncDistance::CALM_WINDOWS_TO_SHRINK; ++i)
+    RunWindow(sync, 0, 0);
+  RunWindow(sync, 1, 1000);
+  for (int i = 1; i < AdaptiveSyncDistance::CALM_WINDOWS_TO_SHRINK; ++i)
+    RunWindow(sync, 0, 0);
+  EXPECT_EQ(75000, sync.GetDistance());
+
+  for (int i = 0; i < 1000; ++i)
+    RunWindow(sync, 0, 0);
+  EXPECT_EQ(LOWER, sync.GetDistance());
+}
+
+TEST(AdaptiveSyncDistance, GrowsOnlyOnManyShortStalls)
+{
+  AdaptiveSyncDistance sync(10000);
+
+  // Too few stalls.
+  RunWindow(sync, AdaptiveSyncDistance::MIN_STALLS_TO_GROW - 1, 1);
+  EXPECT_EQ(10000, sync.GetDistance());
+
+  // The GPU thread is just slower, which a larger distance doesn't help with.
+  RunWindow(sync, AdaptiveSyncDistance::MIN_STALLS_TO_GROW,
+            AdaptiveSyncDistance::SHORT_STALL_US * 10);
+  EXPECT_EQ(10000, sync.GetDistance());
+
+  RunWindow(sync, AdaptiveSyncDistance::MIN_STALLS_TO_GROW, 1);
+  EXPECT_EQ(13500, sync.GetDistance());
+
+  for (int i = 0; i < 100; ++i)
+    RunWindow(sync, AdaptiveSyncDistance::MIN_STALLS_TO_GROW, 1);
+  EXPECT_EQ(UPPER, sync.GetDistance());
+}
+
+// The CPU thread keeps running into short handshake stalls while the distance is below a noisy
+// threshold, which alternates between two levels. The distance must settle close above the
+// threshold: it should rarely stall, only turn around because of a stall, and stay far from the
+// upper bound.
+TEST(AdaptiveSyncDistance, SettlesOnNoisyWorkload)
+{
+  constexpr int NUM_WINDOWS = 2000;
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> noise(-5000, 5000);
+
+  AdaptiveSyncDistance sync(UPPER);
+  int windows_with_stalls = 0;
+  int reversals = 0;
+  int last_direction = 0;
+  s64 distance_sum = 0;
+  for (int i = 0; i < NUM_WINDOWS; ++i)
+  {
+    const int threshold = ((i / 100) % 2 == 0 ? 60000 : 80000) + noise(rng);
+    const int before = sync.GetDistance();
+    if (before < threshold)
+    {
+      windows_with_stalls++;
+      RunWindow(sync, 5, 10);
+    }
+    else
+    {
+      RunWindow(sync, 0, 0);
+    }
+
+    distance_sum += sync.GetDistance();
+
+    const int direction = (sync.GetDistance() > before) - (sync.GetDistance() < before);
+    if (direction != 0)
+    {
+      if (last_direction != 0 && direction != last_direction)
+        reversals++;
+      last_direction = direction;
+    }
+  }
+
+  EXPECT_LT(windows_with_stalls, NUM_WINDOWS / 10);
+  // Every stall turns a shrinking distance around, and the next shrink turns it around again.
+  EXPECT_LE(reversals, 2 * windows_with_stalls);
+  EXPECT_LT(distance_sum / NUM_WINDOWS, 100000);
+}
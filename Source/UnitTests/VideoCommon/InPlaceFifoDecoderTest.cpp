@@ -0,0 +1,112 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/InPlaceFifoDecoder.h"
+
+using Fifo::InPlaceFifoDecoder;
+
+namespace
+{
+constexpr u32 FIFO_BASE = 0x00100000;
+// Address of the last block of a four block FIFO.
+constexpr u32 FIFO_END = FIFO_BASE + 0x60;
+
+// Addresses in the fake FIFO memory are offsets into this array. The first byte of each command
+// is its total size.
+std::array<u8, 128 + 4> s_memory;
+std::vector<u32> s_decoded;
+
+u8* DecodeCommands(DataReader src, u32* cycles)
+{
+  while (src.size() != 0 && src.Peek<u8>() <= src.size())
+  {
+    s_decoded.push_back(static_cast<u32>(src.GetPointer() - s_memory.data()));
+    src.Skip(src.Peek<u8>());
+    ++*cycles;
+  }
+  return src.GetPointer();
+}
+
+class InPlaceFifoDecoderTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    s_memory.fill(0);
+    s_decoded.clear();
+    // Commands at 0, 20, 40, 70 and 80, which ends exactly at the end of the FIFO.
+    s_memory[0] = 20;
+    s_memory[20] = 20;
+    s_memory[40] = 30;
+    s_memory[70] = 10;
+    s_memory[80] = 48;
+  }
+
+  // Decodes the size bytes of FIFO data at read_ptr.
+  u32 Run(u32 read_ptr, u32 size, u32 base = FIFO_BASE)
+  {
+    return m_decoder.Decode({base, base + FIFO_END - FIFO_BASE, read_ptr},
+                            &s_memory[read_ptr - base], size, &m_cycles);
+  }
+
+  InPlaceFifoDecoder m_decoder{DecodeCommands};
+  u32 m_cycles = 0;
+};
+}  // namespace
+
+TEST_F(InPlaceFifoDecoderTest, CommandStraddlingTwoRunsIsResumed)
+{
+  // The command at 40 continues past the first two blocks.
+  EXPECT_EQ(40u, Run(FIFO_BASE, 64));
+  EXPECT_EQ(8u, m_decoder.GetOffset({FIFO_BASE, FIFO_END, FIFO_BASE + 32}));
+
+  // The read pointer only advanced by one block, and decoding continues in the middle of it.
+  EXPECT_EQ(96u, Run(FIFO_BASE + 32, 96));
+  EXPECT_EQ((std::vector<u32>{0, 20, 40, 70, 80}), s_decoded);
+  EXPECT_EQ(5u, m_cycles);
+  EXPECT_EQ(0u, m_decoder.GetOffset({FIFO_BASE, FIFO_END, FIFO_BASE + 128}));
+}
+
+TEST_F(InPlaceFifoDecoderTest, RewrittenReadPointerDropsPartialBlock)
+{
+  EXPECT_EQ(40u, Run(FIFO_BASE, 64));
+
+  // The CPU thread pointed the read pointer back at the start of the FIFO, so decoding starts
+  // over at the first command instead of at offset 8 of the first block.
+  EXPECT_EQ(40u, Run(FIFO_BASE, 64));
+  EXPECT_EQ((std::vector<u32>{0, 20, 0, 20}), s_decoded);
+}
+
+TEST_F(InPlaceFifoDecoderTest, MovedFifoDropsPartialBlock)
+{
+  EXPECT_EQ(40u, Run(FIFO_BASE, 64));
+
+  // Same read pointer, but the end of the FIFO was moved.
+  EXPECT_EQ(0u, m_decoder.GetOffset({FIFO_BASE, FIFO_END + 32, FIFO_BASE + 32}));
+  // Once dropped, the offset doesn't come back when the FIFO is moved back.
+  EXPECT_EQ(0u, m_decoder.GetOffset({FIFO_BASE, FIFO_END, FIFO_BASE + 32}));
+
+  EXPECT_EQ(128u, Run(FIFO_BASE, 128));
+  EXPECT_EQ((std::vector<u32>{0, 20, 0, 20, 40, 70, 80}), s_decoded);
+}
+
+TEST_F(InPlaceFifoDecoderTest, OffsetFromCopyingPathIsResumed)
+{
+  // The copying path decoded the first 70 bytes, leaving the rest of the third block.
+  m_decoder.SetOffset({FIFO_BASE, FIFO_END, FIFO_BASE + 64}, 6);
+  EXPECT_EQ(64u, Run(FIFO_BASE + 64, 64));
+  EXPECT_EQ((std::vector<u32>{70, 80}), s_decoded);
+}
+
+TEST_F(InPlaceFifoDecoderTest, CommandThatNeverFitsMakesNoProgress)
+{
+  m_decoder.SetOffset({FIFO_BASE, FIFO_END, FIFO_BASE + 64}, 16);
+  EXPECT_EQ(16u, Run(FIFO_BASE + 64, 60));
+  EXPECT_TRUE(s_decoded.empty());
+}
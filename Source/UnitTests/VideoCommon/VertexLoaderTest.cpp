@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <chrono>
+#include <cstdio>
 #include <limits>
 #include <memory>
 #include <tuple>
@@ -11,10 +13,12 @@
 #include <gtest/gtest.h>  // NOLINT
 
 #include "Common/BitUtils.h"
+#include "Common/CPUDetect.h"
 #include "Common/Common.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 
@@ -92,6 +96,114 @@ protected:
     EXPECT_EQ(actual_count, expected_count);
   }
 
+  // Creates the JIT vertex loader with or without its AVX2 paths.
+  std::unique_ptr<VertexLoaderBase> CreateJitLoader(bool avx2)
+  {
+    const bool has_avx2 = cpu_info.bAVX2;
+    cpu_info.bAVX2 = avx2;
+    std::unique_ptr<VertexLoaderBase> loader =
+        VertexLoaderBase::CreateVertexLoader(m_vtx_desc, m_vtx_attr);
+    cpu_info.bAVX2 = has_avx2;
+    return loader;
+  }
+
+#ifdef _M_X86_64
+  // Checks that the AVX2 loader, which loads two vertices at once, produces exactly the same
+  // output and zfreeze state as the SSE loader for the current vertex format. position_ofs is the
+  // offset of the position index in the vertex, which is used to skip vertices.
+  void ExpectAVX2MatchesSSE(int position_ofs)
+  {
+    // Pseudo-random vertex and array data.
+    u32 seed = 12345;
+    for (size_t i = 0; i < 1024 * 1024; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      input_memory[i] = static_cast<u8>(seed >> 16);
+    }
+    for (int i = 0; i < 12; i++)
+    {
+      VertexLoaderManager::cached_arraybases[i] = input_memory + 512 * 1024;
+      g_main_cp_state.array_strides[i] = 7 + i;
+    }
+
+    const std::unique_ptr<VertexLoaderBase> sse_loader = CreateJitLoader(false);
+    const std::unique_ptr<VertexLoaderBase> avx2_loader = CreateJitLoader(true);
+    const int vertex_size = sse_loader->m_VertexSize;
+    const int stride = sse_loader->m_native_vtx_decl.stride;
+    ASSERT_EQ(vertex_size, avx2_loader->m_VertexSize);
+    ASSERT_EQ(stride, avx2_loader->m_native_vtx_decl.stride);
+
+    // Skip a few vertices, including ones which would otherwise be loaded as a pair.
+    for (int i : {3, 10, 11, 998})
+    {
+      input_memory[i * vertex_size + position_ofs] = 0xFF;
+      input_memory[i * vertex_size + position_ofs + 1] = 0xFF;
+    }
+
+    struct Result
+    {
+      int count;
+      std::vector<u8> output;
+      float position_cache[3][4];
+      u32 position_matrix_index[4];
+    };
+    const auto run = [&](VertexLoaderBase* loader, int count) {
+      Result result;
+      memset(output_memory, 0, count * stride);
+      memset(VertexLoaderManager::position_cache, 0, sizeof(VertexLoaderManager::position_cache));
+      memset(VertexLoaderManager::position_matrix_index, 0,
+             sizeof(VertexLoaderManager::position_matrix_index));
+      ResetPointers();
+      result.count = loader->RunVertices(m_src, m_dst, count);
+      result.output.assign(output_memory, output_memory + result.count * stride);
+      memcpy(result.position_cache, VertexLoaderManager::position_cache,
+             sizeof(result.position_cache));
+      memcpy(result.position_matrix_index, VertexLoaderManager::position_matrix_index,
+             sizeof(result.position_matrix_index));
+      return result;
+    };
+
+    for (int count : {1, 2, 3, 4, 5, 12, 999, 1000})
+    {
+      SCOPED_TRACE(count);
+      const Result expected = run(sse_loader.get(), count);
+      const Result actual = run(avx2_loader.get(), count);
+      EXPECT_EQ(expected.count, actual.count);
+      EXPECT_EQ(expected.output, actual.output);
+      EXPECT_EQ(0, memcmp(expected.position_cache, actual.position_cache,
+                          sizeof(expected.position_cache)));
+      EXPECT_EQ(0, memcmp(expected.position_matrix_index, actual.position_matrix_index,
+                          sizeof(expected.position_matrix_index)));
+    }
+  }
+#endif
+
+  // Prints the throughput of the scalar, SSE and (if supported) AVX2 vertex loaders for the
+  // current vertex format.
+  void CompareLoaderSpeed(int iterations, int count)
+  {
+    std::vector<std::pair<const char*, std::unique_ptr<VertexLoaderBase>>> loaders;
+    loaders.emplace_back("scalar", std::make_unique<VertexLoader>(m_vtx_desc, m_vtx_attr));
+#ifdef _M_X86_64
+    loaders.emplace_back("SSE", CreateJitLoader(false));
+    if (cpu_info.bAVX2)
+      loaders.emplace_back("AVX2", CreateJitLoader(true));
+#endif
+
+    for (auto& [name, loader] : loaders)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i)
+      {
+        ResetPointers();
+        EXPECT_EQ(count, loader->RunVertices(m_src, m_dst, count));
+      }
+      const std::chrono::duration<double, std::nano> elapsed =
+          std::chrono::steady_clock::now() - start;
+      printf("  %-6s %8.3f ns/vertex\n", name, elapsed.count() / (double(iterations) * count));
+    }
+  }
+
   void ResetPointers()
   {
     m_src = DataReader(input_memory, input_memory + sizeof(input_memory));
@@ -291,6 +403,111 @@ TEST_P(VertexLoaderSpeedTest, TexCoordSingleElement)
     RunVertices(100000);
 }
 
+TEST_P(VertexLoaderSpeedTest, CompareLoadersPositionDirect)
+{
+  int format, elements;
+  std::tie(format, elements) = GetParam();
+  const char* map[] = {"u8", "s8", "u16", "s16", "float"};
+  printf("format: %s, elements: %d\n", map[format], elements);
+  m_vtx_desc.Position = DIRECT;
+  m_vtx_attr.g0.PosFormat = format;
+  m_vtx_attr.g0.PosElements = elements;
+  m_vtx_attr.g0.PosFrac = 4;
+  m_vtx_attr.g0.ByteDequant = true;
+  CompareLoaderSpeed(100, 100000);
+}
+
+TEST_P(VertexLoaderSpeedTest, CompareLoadersIndexedPosNrmTex)
+{
+  int format, elements;
+  std::tie(format, elements) = GetParam();
+  const char* map[] = {"u8", "s8", "u16", "s16", "float"};
+  printf("format: %s, elements: %d\n", map[format], elements);
+  m_vtx_desc.Position = INDEX16;
+  m_vtx_desc.Normal = INDEX16;
+  m_vtx_desc.Color0 = DIRECT;
+  m_vtx_desc.Tex0Coord = INDEX16;
+  m_vtx_attr.g0.PosFormat = format;
+  m_vtx_attr.g0.PosElements = elements;
+  m_vtx_attr.g0.NormalFormat = FORMAT_BYTE;
+  m_vtx_attr.g0.Color0Comp = FORMAT_32B_8888;
+  m_vtx_attr.g0.Tex0CoordFormat = format;
+  m_vtx_attr.g0.Tex0CoordElements = 1;
+  m_vtx_attr.g0.Tex0Frac = 8;
+  m_vtx_attr.g0.ByteDequant = true;
+
+  for (int i = 0; i < 12; i++)
+  {
+    VertexLoaderManager::cached_arraybases[i] = input_memory + 8 * 1024 * 1024;
+    g_main_cp_state.array_strides[i] = 12;
+  }
+  CompareLoaderSpeed(100, 100000);
+}
+
+#ifdef _M_X86_64
+TEST_F(VertexLoaderTest, AVX2MatchesSSE)
+{
+  if (!cpu_info.bAVX2)
+    return;
+
+  m_vtx_desc.PosMatIdx = 1;
+  m_vtx_desc.Tex1MatIdx = 1;
+  m_vtx_desc.Position = INDEX16;
+  m_vtx_desc.Normal = DIRECT;
+  m_vtx_desc.Color0 = DIRECT;
+  m_vtx_desc.Color1 = INDEX8;
+  m_vtx_desc.Tex0Coord = INDEX8;
+  m_vtx_desc.Tex1Coord = DIRECT;
+  m_vtx_attr.g0.PosElements = 1;
+  m_vtx_attr.g0.PosFormat = FORMAT_SHORT;
+  m_vtx_attr.g0.PosFrac = 5;
+  m_vtx_attr.g0.NormalElements = 1;
+  m_vtx_attr.g0.NormalFormat = FORMAT_BYTE;
+  m_vtx_attr.g0.Color0Comp = FORMAT_16B_565;
+  m_vtx_attr.g0.Color1Comp = FORMAT_24B_6666;
+  m_vtx_attr.g0.Tex0CoordElements = 1;
+  m_vtx_attr.g0.Tex0CoordFormat = FORMAT_USHORT;
+  m_vtx_attr.g0.Tex0Frac = 7;
+  m_vtx_attr.g1.Tex1CoordElements = 0;
+  m_vtx_attr.g1.Tex1CoordFormat = FORMAT_FLOAT;
+  m_vtx_attr.g0.ByteDequant = true;
+
+  ExpectAVX2MatchesSSE(2);
+}
+
+TEST_F(VertexLoaderTest, AVX2MatchesSSEWithPositionLast)
+{
+  if (!cpu_info.bAVX2)
+    return;
+
+  // The position index is the last attribute, directly followed by the position matrix index of
+  // the next vertex.
+  m_vtx_desc.PosMatIdx = 1;
+  m_vtx_desc.Position = INDEX16;
+  m_vtx_attr.g0.PosElements = 1;
+  m_vtx_attr.g0.PosFormat = FORMAT_FLOAT;
+
+  ExpectAVX2MatchesSSE(1);
+}
+
+TEST_F(VertexLoaderTest, AVX2MatchesSSEWithTexMatrixLast)
+{
+  if (!cpu_info.bAVX2)
+    return;
+
+  m_vtx_desc.PosMatIdx = 1;
+  m_vtx_desc.Tex0MatIdx = 1;
+  m_vtx_desc.Position = INDEX16;
+  m_vtx_desc.Normal = DIRECT;
+  m_vtx_attr.g0.PosElements = 1;
+  m_vtx_attr.g0.PosFormat = FORMAT_SHORT;
+  m_vtx_attr.g0.NormalElements = 1;
+  m_vtx_attr.g0.NormalFormat = FORMAT_SHORT;
+
+  ExpectAVX2MatchesSSE(2);
+}
+#endif
+
 TEST_F(VertexLoaderTest, LargeFloatVertexSpeed)
 {
   // Enables most attributes in floating point indexed mode to test speed.
@@ -0,0 +1,42 @@
+#!/bin/bash
+#
+# Measures how the software renderer scales with the number of rasterizer threads,
+# by playing back a FIFO log once per thread count and averaging the logged frame times.
+#
+# Example usage:
+# $ ./Tools/sw-rasterizer-benchmark.sh ./build/Binaries/dolphin-emu-nogui game.dff 1 2 4 8
+#
+# The output of the software renderer doesn't depend on the thread count, so frame dumps
+# (-C GFX.Settings.DumpFrames=True) of different runs can be compared to check for regressions.
+
+set -euo pipefail
+
+if [ $# -lt 3 ]; then
+  echo >&2 "usage: $0 <dolphin-emu-nogui> <fifo log> <thread count>..."
+  exit 1
+fi
+
+dolphin=$1
+fifo_log=$2
+shift 2
+
+duration=${DURATION:-30}
+
+for threads in "$@"; do
+  user_dir=$(mktemp -d)
+  timeout --preserve-status -s INT "${duration}" "${dolphin}" -p headless -u "${user_dir}" \
+    -v "Software Renderer" -e "${fifo_log}" \
+    -C GFX.Settings.SWRasterizerThreads="${threads}" \
+    -C GFX.Settings.LogRenderTimeToFile=True >/dev/null 2>&1 || true
+
+  render_times="${user_dir}/Logs/render_time.txt"
+  if [ -f "${render_times}" ]; then
+    # The first frames include shader and texture setup, so skip them.
+    awk -v threads="${threads}" 'NR > 10 { sum += $1; n++ }
+      END { if (n) printf "%2d threads: %8.3f ms/frame (%d frames)\n", threads, sum / n, n }' \
+      "${render_times}"
+  else
+    echo "${threads} threads: no frames rendered"
+  fi
+  rm -rf "${user_dir}"
+done